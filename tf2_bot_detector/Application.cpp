@@ -69,6 +69,7 @@ TF2BDApplication::TF2BDApplication() :
 	s_Application = this;
 
 	m_TempDB = DB::ITempDB::Create();
+	m_TempDB->SetSizeBudget(m_Settings.GetTempDBSizeBudget());
 
 	// moved from mainwindow
 	ILogManager::GetInstance().CleanupLogFiles();
@@ -1,13 +1,26 @@
 #pragma once
 
 #include "Clock.h"
+#include "GlobalDispatcher.h"
 #include "Log.h"
 
+#include <mh/coroutine/task.hpp>
+
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 
 namespace tf2_bot_detector
 {
+	/// <summary>
+	/// Collects items into batches and sends a request for each batch. A batch goes out as soon
+	/// as it is full, or after a short linger so that items queued together (a whole lobby
+	/// joining at once) share a request. Several batches can be in flight at once.
+	///
+	/// OnDataReady() is always called on the main thread. Items it leaves in the collection, and
+	/// the items of batches that failed, are queued again and retried after a while.
+	/// </summary>
 	template<typename TState, typename TItem, typename TResponse>
 	class BatchedAction
 	{
@@ -24,74 +37,157 @@ namespace tf2_bot_detector
 		bool IsQueued(const TItem& item) const
 		{
 			std::lock_guard lock(m_Mutex);
-			return m_Queued.contains(item);
+			return m_Queued.contains(item) || m_InFlight.contains(item);
 		}
 
 		void Queue(TItem&& item)
 		{
 			std::lock_guard lock(m_Mutex);
-			m_Queued.insert(std::move(item));
+			if (m_InFlight.contains(item) || !m_Queued.insert(std::move(item)).second)
+				return;
+
+			OnItemQueued();
 		}
 		void Queue(const TItem& item)
 		{
 			std::lock_guard lock(m_Mutex);
-			m_Queued.insert(item);
+			if (m_InFlight.contains(item) || !m_Queued.insert(item).second)
+				return;
+
+			OnItemQueued();
+		}
+
+	protected:
+		/// <summary>
+		/// Sends the request for one batch, of at most MAX_BATCH_SIZE items.
+		/// </summary>
+		virtual response_future_type SendRequest(state_type& state, queue_collection_type& collection) = 0;
+		virtual void OnDataReady(state_type& state, const response_type& response, queue_collection_type& collection) = 0;
+
+	private:
+		static constexpr size_t MAX_BATCH_SIZE = 100;      // The most SteamIDs the batched APIs take per request
+		static constexpr size_t MAX_IN_FLIGHT_BATCHES = 4; // The HTTP client throttles per host on top of this
+		static constexpr duration_t LINGER_TIME = std::chrono::milliseconds(100);
+		static constexpr duration_t RETRY_TIME = std::chrono::seconds(5);
+
+		void OnItemQueued()
+		{
+			if (m_Queued.size() >= MAX_BATCH_SIZE)
+				SendBatches();
+			else
+				ScheduleSend(LINGER_TIME);
 		}
 
-		void Update()
+		void ScheduleSend(duration_t delay)
 		{
-			std::invoke([&]
+			const auto sendTime = clock_t::now() + delay;
+			if (m_ScheduledSendTime && *m_ScheduledSendTime <= sendTime)
+				return; // Already going to send by then
+
+			m_ScheduledSendTime = sendTime;
+			[](BatchedAction* self, std::weak_ptr<LifetimeToken> lifetime, duration_t delay, time_point_t sendTime) -> mh::task<>
+			{
+				co_await GetDispatcher().co_delay_for(delay);
+				if (lifetime.expired())
+					co_return;
+
+				std::lock_guard lock(self->m_Mutex);
+				if (self->m_ScheduledSendTime == sendTime)
+					self->m_ScheduledSendTime.reset();
+
+				self->SendBatches();
+			}(this, m_Lifetime, delay, sendTime);
+		}
+
+		void SendBatches()
+		{
+			while (!m_Queued.empty() && m_InFlightBatchCount < MAX_IN_FLIGHT_BATCHES)
+			{
+				queue_collection_type batch;
+				while (!m_Queued.empty() && batch.size() < MAX_BATCH_SIZE)
 				{
-					if (m_Queued.empty())
-						return;
+					auto node = m_Queued.extract(m_Queued.begin());
+					m_InFlight.insert(node.value());
+					batch.insert(std::move(node));
+				}
+
+				m_InFlightBatchCount++;
+				RunBatch(std::move(batch));
+			}
+		}
 
-					if (m_ResponseFuture.valid())
-						return;
+		mh::task<> RunBatch(queue_collection_type batch)
+		{
+			std::weak_ptr<LifetimeToken> lifetime = m_Lifetime;
 
-					const auto curTime = clock_t::now();
-					if (curTime < (m_LastUpdate + MIN_INTERVAL))
-						return;
+			std::optional<response_type> response;
+			try
+			{
+				response_future_type responseFuture = SendRequest(m_State, batch);
+				if (responseFuture.valid())
+					response = co_await responseFuture;
+			}
+			catch (const std::exception& e)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to get batched action future");
+			}
 
-					m_LastUpdate = curTime;
+			co_await GetDispatcher().co_dispatch(); // OnDataReady() needs the main thread
+			if (lifetime.expired())
+				co_return;
 
-					m_ResponseFuture = SendRequest(m_State, m_Queued);
-				});
+			std::lock_guard lock(m_Mutex);
+			m_InFlightBatchCount--;
+			for (const auto& item : batch)
+				m_InFlight.erase(item);
 
-			if (m_ResponseFuture.is_ready())
+			if (response)
 			{
-				std::lock_guard lock(m_Mutex);
 				try
 				{
-					const auto& response = m_ResponseFuture.get();
-
-					try
-					{
-						OnDataReady(m_State, response, m_Queued);
-					}
-					catch (const std::exception& e)
-					{
-						LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to process batched action");
-					}
+					OnDataReady(m_State, *response, batch);
 				}
 				catch (const std::exception& e)
 				{
-					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to get batched action future");
+					LogException(MH_SOURCE_LOCATION_CURRENT(), e, "Failed to process batched action");
 				}
-
-				m_ResponseFuture = {};
 			}
+
+			if (!batch.empty())
+				RetryLater(std::move(batch));
+
+			SendBatches(); // Anything that was waiting on a free slot
 		}
 
-	protected:
-		virtual response_future_type SendRequest(state_type& state, queue_collection_type& collection) = 0;
-		virtual void OnDataReady(state_type& state, const response_type& response, queue_collection_type& collection) = 0;
+		void RetryLater(queue_collection_type items)
+		{
+			// Still counts as in flight, so queuing them again in the meantime doesn't send them early
+			for (const auto& item : items)
+				m_InFlight.insert(item);
+
+			[](BatchedAction* self, std::weak_ptr<LifetimeToken> lifetime, queue_collection_type items) -> mh::task<>
+			{
+				co_await GetDispatcher().co_delay_for(RETRY_TIME);
+				if (lifetime.expired())
+					co_return;
+
+				std::lock_guard lock(self->m_Mutex);
+				for (const auto& item : items)
+					self->m_InFlight.erase(item);
+
+				self->m_Queued.merge(items);
+				self->SendBatches();
+			}(this, m_Lifetime, std::move(items));
+		}
+
+		struct LifetimeToken {};
+		const std::shared_ptr<LifetimeToken> m_Lifetime = std::make_shared<LifetimeToken>();
 
-	private:
-		static constexpr duration_t MIN_INTERVAL = std::chrono::seconds(5);
 		state_type m_State{};
-		std::recursive_mutex m_Mutex;
+		mutable std::recursive_mutex m_Mutex;
 		queue_collection_type m_Queued;
-		response_future_type m_ResponseFuture;
-		time_point_t m_LastUpdate{};
+		queue_collection_type m_InFlight; // Sent, or waiting to be retried
+		size_t m_InFlightBatchCount = 0;
+		std::optional<time_point_t> m_ScheduledSendTime;
 	};
 }
@@ -2,15 +2,21 @@
 #include "SteamID.h"
 #include "Util/JSONUtils.h"
 #include "Application.h"
+#include "GlobalDispatcher.h"
 #include "DB/TempDB.h"
+#include "Filesystem.h"
+#include "Util/AccountAgeIndex.h"
 
+#include <mh/concurrency/thread_pool.hpp>
 #include <mh/concurrency/thread_sentinel.hpp>
+#include <mh/coroutine/task.hpp>
 #include <mh/error/not_implemented_error.hpp>
 #include <mh/math/interpolation.hpp>
 #include <mh/source_location.hpp>
 #include <nlohmann/json.hpp>
 
 #include <cassert>
+#include <memory>
 
 using namespace tf2_bot_detector;
 
@@ -23,18 +29,57 @@ namespace
 {
 	/// Estimates an account's steam account age, by given steamid.
 	/// TODO: move this to Util/, because this has nothing to do with config.
-	class AccountAges final : public IAccountAges
+	class AccountAges final : public IAccountAges, public std::enable_shared_from_this<AccountAges>
 	{
 	public:
 		void OnDataReady(const SteamID& id, time_point_t creationTime) override;
 
 		std::optional<time_point_t> EstimateAccountCreationTime(const SteamID& id) const override;
 
+		mh::task<size_t> ExportAsync(std::filesystem::path path) const override;
+		mh::task<size_t> ImportAsync(std::filesystem::path path) override;
+
 	private:
 		[[nodiscard]] bool CheckSteamIDValid(const SteamID& id, MH_SOURCE_LOCATION_AUTO(location)) const;
+
+		// The temp DB doesn't exist yet when we are created, so the index is loaded on first use
+		void LoadIndex() const;
+		static mh::task<> LoadIndexAsync(std::weak_ptr<const AccountAges> weakThis);
+		std::optional<time_point_t> EstimateFromTempDB(const SteamID& id) const;
+
+		enum class IndexState
+		{
+			Unloaded,
+			Loading,
+			Loaded,
+		};
+
+		mh::thread_sentinel m_Sentinel;
+		mutable IndexState m_IndexState = IndexState::Unloaded;
+
+		// While loading, only holds what arrived in the meantime
+		mutable AccountAgeIndex m_Index;
 	};
 }
 
+// Loading, importing and exporting all happen here, so they never hold up the main thread
+static mh::thread_pool& GetAccountAgesPool()
+{
+	static mh::thread_pool s_Pool(1);
+	return s_Pool;
+}
+
+static std::vector<AccountAgeIndex::Sample> LoadSamplesFromTempDB()
+{
+	std::vector<AccountAgeIndex::Sample> samples;
+	TF2BDApplication::GetApplication().GetTempDB().ForEachAccountAgeInfo([&](const DB::AccountAgeInfo& info)
+		{
+			samples.push_back(AccountAgeIndex::MakeSample(info.m_SteamID.GetAccountID(), info.m_CreationTime));
+		});
+
+	return samples;
+}
+
 std::shared_ptr<IAccountAges> tf2_bot_detector::IAccountAges::Create()
 {
 	return std::make_shared<AccountAges>();
@@ -53,9 +98,14 @@ bool AccountAges::CheckSteamIDValid(const SteamID& id, const mh::source_location
 
 void AccountAges::OnDataReady(const SteamID& id, time_point_t creationTime)
 {
+	m_Sentinel.check();
+
 	if (!CheckSteamIDValid(id))
 		return;
 
+	LoadIndex();
+	m_Index.Insert(id.GetAccountID(), creationTime);
+
 	DB::ITempDB& tempDB = TF2BDApplication::GetApplication().GetTempDB();
 	DB::AccountAgeInfo info{};
 	info.m_SteamID = id;
@@ -65,9 +115,109 @@ void AccountAges::OnDataReady(const SteamID& id, time_point_t creationTime)
 
 std::optional<time_point_t> AccountAges::EstimateAccountCreationTime(const SteamID& id) const
 {
+	m_Sentinel.check();
+
 	if (!CheckSteamIDValid(id))
 		return std::nullopt;
 
+	LoadIndex();
+	if (m_IndexState == IndexState::Loaded)
+		return m_Index.EstimateCreationTime(id.GetAccountID());
+
+	return EstimateFromTempDB(id);
+}
+
+void AccountAges::LoadIndex() const
+{
+	if (m_IndexState != IndexState::Unloaded)
+		return;
+
+	m_IndexState = IndexState::Loading;
+	LoadIndexAsync(weak_from_this());
+}
+
+mh::task<> AccountAges::LoadIndexAsync(std::weak_ptr<const AccountAges> weakThis)
+{
+	co_await GetAccountAgesPool().co_add_task();
+
+	const auto startTime = clock_t::now();
+
+	AccountAgeIndex index;
+	try
+	{
+		index.Insert(LoadSamplesFromTempDB());
+	}
+	catch (...)
+	{
+		// Stays in the loading state, so estimates keep coming from the temp DB
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load account ages");
+		co_return;
+	}
+
+	co_await GetDispatcher().co_dispatch();
+
+	auto pThis = weakThis.lock();
+	if (!pThis)
+		co_return;
+
+	// Anything that arrived while we were loading is newer than what was in the DB
+	index.Insert(pThis->m_Index.GetSamples());
+	pThis->m_Index = std::move(index);
+	pThis->m_IndexState = IndexState::Loaded;
+
+	DebugLog("Loaded {} account ages in {} seconds", pThis->m_Index.size(), to_seconds(clock_t::now() - startTime));
+}
+
+mh::task<size_t> AccountAges::ExportAsync(std::filesystem::path path) const
+{
+	m_Sentinel.check();
+
+	// Prefer the index, it has everything still waiting to be written to the temp DB
+	std::optional<AccountAgeIndex> index;
+	if (m_IndexState == IndexState::Loaded)
+		index = m_Index;
+
+	co_await GetAccountAgesPool().co_add_task();
+
+	if (!index)
+	{
+		index.emplace();
+		index->Insert(LoadSamplesFromTempDB());
+	}
+
+	IFilesystem::Get().WriteFile(path, AccountAgeIndex::Serialize(index->GetSamples()), PathUsage::WriteLocal);
+	Log("Exported {} account ages to {}", index->size(), path);
+	co_return index->size();
+}
+
+mh::task<size_t> AccountAges::ImportAsync(std::filesystem::path path)
+{
+	m_Sentinel.check();
+
+	std::weak_ptr<AccountAges> weakThis = weak_from_this();
+	LoadIndex();
+
+	co_await GetAccountAgesPool().co_add_task();
+
+	const auto startTime = clock_t::now();
+	std::vector<AccountAgeIndex::Sample> samples = AccountAgeIndex::Deserialize(IFilesystem::Get().ReadFile(path));
+	const size_t count = samples.size();
+
+	TF2BDApplication::GetApplication().GetTempDB().StoreAccountAges(samples);
+
+	co_await GetDispatcher().co_dispatch();
+
+	// LoadIndex() queued loading ahead of us on the same thread, so by now the index is loaded
+	// (without these), unless loading failed and estimates are coming from the temp DB anyway
+	if (auto pThis = weakThis.lock(); pThis && pThis->m_IndexState == IndexState::Loaded)
+		pThis->m_Index.Insert(std::move(samples));
+
+	Log("Imported {} account ages from {} in {} seconds", count, path, to_seconds(clock_t::now() - startTime));
+	co_return count;
+}
+
+std::optional<time_point_t> AccountAges::EstimateFromTempDB(const SteamID& id) const
+{
 	std::optional<DB::AccountAgeInfo> lower, upper;
 	TF2BDApplication::GetApplication().GetTempDB().GetNearestAccountAgeInfos(id, lower, upper);
 
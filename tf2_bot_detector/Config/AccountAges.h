@@ -3,6 +3,9 @@
 #include "Clock.h"
 #include "SteamID.h"
 
+#include <mh/coroutine/task.hpp>
+
+#include <filesystem>
 #include <optional>
 
 namespace tf2_bot_detector
@@ -19,5 +22,16 @@ namespace tf2_bot_detector
 		virtual void OnDataReady(const SteamID& id, time_point_t creationTime) = 0;
 
 		virtual std::optional<time_point_t> EstimateAccountCreationTime(const SteamID& id) const = 0;
+
+		/// <summary>
+		/// Writes every known account age to a file (see AccountAgeIndex::Serialize()), so it can be
+		/// imported on another machine. Returns how many were written.
+		/// </summary>
+		virtual mh::task<size_t> ExportAsync(std::filesystem::path path) const = 0;
+
+		/// <summary>
+		/// Adds the account ages from a file written by ExportAsync(). Returns how many were read.
+		/// </summary>
+		virtual mh::task<size_t> ImportAsync(std::filesystem::path path) = 0;
 	};
 }
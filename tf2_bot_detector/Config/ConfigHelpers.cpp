@@ -1,4 +1,6 @@
 #include "ConfigHelpers.h"
+#include "ConfigSnapshot.h"
+#include "ConfigWriter.h"
 #include "Networking/HTTPClient.h"
 #include "Networking/HTTPHelpers.h"
 #include "Platform/Platform.h"
@@ -9,12 +11,16 @@
 #include "Version.h"
 #include "Settings.h"
 
+#include <mh/concurrency/thread_pool.hpp>
 #include <mh/text/formatters/error_code.hpp>
 #include <mh/text/case_insensitive_string.hpp>
 #include <mh/text/string_insertion.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
+#include <exception>
 #include <regex>
+#include <thread>
 
 using namespace std::string_literals;
 using namespace std::string_view_literals;
@@ -54,9 +60,76 @@ auto tf2_bot_detector::GetConfigFilePaths(const std::string_view& basename) -> C
 	return retVal;
 }
 
-static void SaveJSONToFile(const std::filesystem::path& filename, const nlohmann::json& json)
+static std::string FormatConfigJSON(const nlohmann::json& json)
 {
-	IFilesystem::Get().WriteFile(filename, json.dump(1, '\t', true, nlohmann::detail::error_handler_t::ignore) << '\n', PathUsage::WriteRoaming);
+	return json.dump(1, '\t', true, nlohmann::detail::error_handler_t::ignore) << '\n';
+}
+
+// Where things derived from a config file (snapshots, auto-update state) are cached
+static std::filesystem::path GetConfigCachePath(const std::filesystem::path& resolvedPath, const std::string_view& extension)
+{
+	return IFilesystem::Get().GetLocalAppDataDir() / "cache" / "config" / mh::format("{}.{}", resolvedPath.filename().string(), extension);
+}
+
+// Config files are parsed (and auto-updated) here, so a group's files all load at once
+static mh::thread_pool& GetConfigLoadingPool()
+{
+	static mh::thread_pool s_Pool(std::max(std::thread::hardware_concurrency(), 2u));
+	return s_Pool;
+}
+
+// Streamed elements are deserialized while parsing, before the schema has been checked. If any of
+// them fail, the first failure is returned in elementError rather than thrown, so the caller can
+// still validate the schema and treat it as a deserialize failure.
+static nlohmann::json ParseConfigJSON(ConfigFileBase& config, const std::string_view& text,
+	std::exception_ptr& elementError)
+{
+	config.ResetStreamedElements();
+	elementError = nullptr;
+
+	const std::string_view streamedArrayName = config.GetStreamedArrayName();
+	if (streamedArrayName.empty())
+		return nlohmann::json::parse(text.begin(), text.end());
+
+	using parse_event_t = nlohmann::json::parse_event_t;
+	bool isStreamedKey = false;
+	bool isInStreamedArray = false;
+	return nlohmann::json::parse(text.begin(), text.end(),
+		[&](int depth, parse_event_t event, nlohmann::json& parsed)
+		{
+			if (depth == 1)
+			{
+				if (event == parse_event_t::key)
+					isStreamedKey = parsed.is_string() && parsed.get_ref<const std::string&>() == streamedArrayName;
+				else if (event == parse_event_t::array_start)
+					isInStreamedArray = isStreamedKey;
+				else if (event == parse_event_t::array_end)
+					isInStreamedArray = false;
+			}
+			else if (depth == 2 && isInStreamedArray && event == parse_event_t::object_end)
+			{
+				try
+				{
+					config.DeserializeStreamedElement(parsed);
+				}
+				catch (...)
+				{
+					if (!elementError)
+						elementError = std::current_exception();
+				}
+
+				return false; // Don't keep it in the DOM
+			}
+
+			return true;
+		});
+}
+
+static void LogConfigFileLoaded(const std::filesystem::path& filename, time_point_t startTime)
+{
+	// Peak RAM usage is for the whole process so far, not just this file
+	Log("Loaded {} in {} seconds (process peak RAM usage so far {:1.1f} MB)", filename,
+		to_seconds(clock_t::now() - startTime), Platform::Processes::GetPeakRAMUsage() / 1024.0f / 1024);
 }
 
 static ConfigSchemaInfo LoadAndValidateSchema(const ConfigFileBase& config, const nlohmann::json& json)
@@ -70,33 +143,110 @@ static ConfigSchemaInfo LoadAndValidateSchema(const ConfigFileBase& config, cons
 	return schema;
 }
 
-static mh::task<bool> TryAutoUpdate(std::filesystem::path filename, const nlohmann::json& existingJson,
-	SharedConfigFileBase& config, const HTTPClient& client)
+// The validators of the response a config file was last auto-updated from. They are only sent
+// back while the file still hashes to what we wrote, so local edits always get overwritten.
+static IHTTPClient::CacheValidators LoadUpdateValidators(const std::filesystem::path& filename,
+	const std::string& updateURL, const std::optional<uint64_t>& contentHash) try
+{
+	if (!contentHash)
+		return {};
+
+	const auto statePath = GetConfigCachePath(IFilesystem::Get().ResolvePath(filename, PathUsage::Read), "update.json");
+	if (!std::filesystem::exists(statePath))
+		return {};
+
+	const auto state = nlohmann::json::parse(IFilesystem::Get().ReadFile(statePath));
+	if (state.at("update_url").get<std::string_view>() != updateURL ||
+		state.at("content_hash").get<uint64_t>() != *contentHash)
+	{
+		DebugLog("Not sending cache validators for {}: file has changed since it was last updated", filename);
+		return {};
+	}
+
+	IHTTPClient::CacheValidators retVal;
+	retVal.m_ETag = state.value("etag", "");
+	retVal.m_LastModified = state.value("last_modified", "");
+	return retVal;
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load auto-update state for {}", filename);
+	return {};
+}
+
+static void SaveUpdateValidators(const std::filesystem::path& filename, const std::string& updateURL,
+	const IHTTPClient::CacheValidators& validators) try
+{
+	const auto path = IFilesystem::Get().ResolvePath(filename, PathUsage::Read);
+
+	nlohmann::json state
+	{
+		{ "update_url", updateURL },
+		{ "content_hash", ConfigSnapshotKey::HashContents(IFilesystem::Get().ReadFile(path)) },
+	};
+
+	if (!validators.m_ETag.empty())
+		state["etag"] = validators.m_ETag;
+	if (!validators.m_LastModified.empty())
+		state["last_modified"] = validators.m_LastModified;
+
+	IFilesystem::Get().WriteFile(GetConfigCachePath(path, "update.json"), state.dump(1, '\t'), PathUsage::WriteLocal);
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to save auto-update state for {}", filename);
+}
+
+enum class AutoUpdateResult
+{
+	Skipped,           // Nothing to update from, or the update failed before touching the config
+	NotModified,       // The server says the file hasn't changed since we last downloaded it
+	Updated,
+	DeserializeFailed, // The update failed partway through deserializing over the config
+};
+
+static mh::task<AutoUpdateResult> TryAutoUpdate(std::filesystem::path filename, const nlohmann::json& existingJson,
+	SharedConfigFileBase& config, const HTTPClient& client, std::optional<uint64_t> contentHash)
 {
 	auto fileInfoJson = existingJson.find("file_info");
 	if (fileInfoJson == existingJson.end())
 	{
 		DebugLog("Skipping auto-update of {}: file_info object missing", filename);
-		co_return false;
+		co_return AutoUpdateResult::Skipped;
 	}
 
 	const ConfigFileInfo info(*fileInfoJson);
 	if (info.m_UpdateURL.empty())
 	{
 		DebugLog("Skipping auto-update of {}: update_url was empty", filename);
-		co_return false;
+		co_return AutoUpdateResult::Skipped;
 	}
 
+	IHTTPClient::ConditionalResponse response;
 	nlohmann::json newJson;
+	std::exception_ptr newElementError;
 	try
 	{
-		newJson = nlohmann::json::parse(co_await client.GetStringAsync(info.m_UpdateURL));
+		response = co_await client.GetStringIfModifiedAsync(info.m_UpdateURL,
+			LoadUpdateValidators(filename, info.m_UpdateURL, contentHash));
+
+		// The download doesn't necessarily finish on the thread we started on
+		co_await GetConfigLoadingPool().co_add_task();
+
+		if (response.m_NotModified)
+		{
+			DebugLog("{} is already up to date with {}", filename, info.m_UpdateURL);
+			co_return AutoUpdateResult::NotModified;
+		}
+
+		newJson = ParseConfigJSON(config, response.m_Body, newElementError);
+		response.m_Body = {};
 	}
 	catch (...)
 	{
 		LogException(MH_SOURCE_LOCATION_CURRENT(),
 			"Failed to auto-update {}: failed to parse new json from {}", filename, info.m_UpdateURL);
-		co_return false;
+		co_return AutoUpdateResult::Skipped;
 	}
 
 	try
@@ -107,7 +257,7 @@ static mh::task<bool> TryAutoUpdate(std::filesystem::path filename, const nlohma
 	{
 		LogException(MH_SOURCE_LOCATION_CURRENT(),
 			"Failed to auto-update {} from {}: new json failed schema validation", filename, info.m_UpdateURL);
-		co_return false;
+		co_return AutoUpdateResult::Skipped;
 	}
 
 	ConfigFileInfo fileInfo;
@@ -120,12 +270,19 @@ static mh::task<bool> TryAutoUpdate(std::filesystem::path filename, const nlohma
 	{
 		LogException(MH_SOURCE_LOCATION_CURRENT(),
 			"Failed to auto-update {} from {}: failed to parse file info from new json", filename, info.m_UpdateURL);
-		co_return false;
+		co_return AutoUpdateResult::Skipped;
 	}
 
 	if (fileInfo.m_Title.empty())
 		fileInfo.m_Title = filename.string();
 
+	if (newElementError)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), newElementError,
+			"Failed to auto-update {}: failed to deserialize response from {}", filename, info.m_UpdateURL);
+		co_return AutoUpdateResult::Skipped;
+	}
+
 	try
 	{
 		config.Deserialize(newJson);
@@ -134,7 +291,7 @@ static mh::task<bool> TryAutoUpdate(std::filesystem::path filename, const nlohma
 	{
 		LogException(MH_SOURCE_LOCATION_CURRENT(),
 			"Failed to auto-update {}: failed to deserialize response from {}", filename, info.m_UpdateURL);
-		co_return false;
+		co_return AutoUpdateResult::DeserializeFailed;
 	}
 
 	if (config.SaveFile(filename))
@@ -145,9 +302,12 @@ static mh::task<bool> TryAutoUpdate(std::filesystem::path filename, const nlohma
 	else
 	{
 		DebugLog(MH_SOURCE_LOCATION_CURRENT(), "Wrote auto-updated config file from {} to {}", info.m_UpdateURL, filename);
+
+		if (!response.m_Validators.empty())
+			SaveUpdateValidators(filename, info.m_UpdateURL, response.m_Validators);
 	}
 
-	co_return true;
+	co_return AutoUpdateResult::Updated;
 }
 
 void tf2_bot_detector::to_json(nlohmann::json& j, const ConfigSchemaInfo& d)
@@ -201,6 +361,8 @@ mh::task<std::error_condition> tf2_bot_detector::detail::LoadConfigFileAsync(Con
 			Log("Disallowing auto-update of {} because internet connectivity is disabled or unset in settings", filename);
 	}
 
+	// Everything above runs on the calling thread, since Settings::GetHTTPClient() isn't thread safe
+	co_await GetConfigLoadingPool().co_add_task();
 	co_return co_await file.LoadFileAsync(filename, client);
 }
 
@@ -236,7 +398,11 @@ catch (...)
 
 mh::task<std::error_condition> ConfigFileBase::LoadFileAsync(const std::filesystem::path& filename, std::shared_ptr<const HTTPClient> client)
 {
+	// Don't read anything older than what is waiting to be written
+	IConfigWriter::Get().Flush();
+
 	const auto loadResult = co_await LoadFileInternalAsync(filename, client);
+	ResetStreamedElements();
 
 	try
 	{
@@ -254,6 +420,15 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileAsync(const std::filesyst
 		// co_return loadResult;
 	}
 
+	// The file is byte for byte what we saved last time, so there is nothing to normalize
+	if (!loadResult && m_FileUnchanged)
+	{
+		if (!m_SnapshotUpToDate)
+			SaveSnapshot(filename);
+
+		co_return loadResult;
+	}
+
 	if (auto saveResult = SaveFile(filename))
 	{
 		if (loadResult)
@@ -265,10 +440,110 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileAsync(const std::filesyst
 			LogWarning(MH_SOURCE_LOCATION_CURRENT(), "Failed to resave {}", filename);
 		}
 	}
+	else if (!loadResult)
+	{
+		SaveSnapshot(filename);
+	}
 
 	co_return loadResult;
 }
 
+static int64_t GetConfigLastWriteTime(const std::filesystem::path& resolvedPath)
+{
+	return int64_t(std::filesystem::last_write_time(resolvedPath).time_since_epoch().count());
+}
+
+bool ConfigFileBase::TryLoadSnapshot(const std::filesystem::path& filename, nlohmann::json& json,
+	std::optional<std::string>& fileContents, std::optional<uint64_t>& contentHash)
+{
+	const auto snapshotVersion = GetSnapshotVersion();
+	if (!snapshotVersion)
+		return false;
+
+	try
+	{
+		const auto path = IFilesystem::Get().ResolvePath(filename, PathUsage::Read);
+		const auto snapshotPath = GetConfigCachePath(path, "snapshot");
+		if (!std::filesystem::exists(snapshotPath))
+			return false;
+
+		const std::string snapshot = IFilesystem::Get().ReadFile(snapshotPath);
+		ConfigSnapshotReader reader(snapshot);
+		if (reader.GetTypeVersion() != snapshotVersion || reader.GetKey().m_FileSize != std::filesystem::file_size(path))
+		{
+			DebugLog("Snapshot of {} is out of date", filename);
+			return false;
+		}
+
+		// Same size but written since the snapshot was made: only use it if the contents are identical
+		const bool upToDate = reader.GetKey().m_LastWriteTime == GetConfigLastWriteTime(path);
+		if (!upToDate)
+		{
+			fileContents = IFilesystem::Get().ReadFile(path);
+			if (ConfigSnapshotKey::HashContents(*fileContents) != reader.GetKey().m_ContentHash)
+			{
+				DebugLog("Snapshot of {} is out of date", filename);
+				return false;
+			}
+		}
+
+		json = nlohmann::json::parse(reader.GetHeaderJSON());
+		if (const auto streamedArrayName = GetStreamedArrayName(); !streamedArrayName.empty())
+			json[std::string(streamedArrayName)] = nlohmann::json::array();
+
+		ResetStreamedElements();
+		reader.BeginBody();
+		ReadSnapshot(reader);
+
+		DebugLog("Loaded {} from snapshot {}", filename, snapshotPath);
+		contentHash = reader.GetKey().m_ContentHash;
+		m_FileUnchanged = true;
+		m_SnapshotUpToDate = upToDate;
+		return true;
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load the snapshot of {}, parsing it instead", filename);
+		ResetStreamedElements();
+		json = {};
+		return false;
+	}
+}
+
+void ConfigFileBase::SaveSnapshot(const std::filesystem::path& filename) const try
+{
+	const auto snapshotVersion = GetSnapshotVersion();
+	if (!snapshotVersion)
+		return;
+
+	// Key it to the file as it is on disk now, after being resaved
+	const auto path = IFilesystem::Get().ResolvePath(filename, PathUsage::Read);
+	const std::string contents = IFilesystem::Get().ReadFile(path);
+
+	ConfigSnapshotKey key;
+	key.m_FileSize = contents.size();
+	key.m_LastWriteTime = GetConfigLastWriteTime(path);
+	key.m_ContentHash = ConfigSnapshotKey::HashContents(contents);
+
+	// Everything LoadFileInternalAsync reads from the json besides the streamed elements
+	nlohmann::json header = nlohmann::json::object();
+	if (m_LoadedSchema)
+		header["$schema"] = *m_LoadedSchema;
+	if (auto shared = dynamic_cast<const SharedConfigFileBase*>(this); shared && shared->m_FileInfo)
+		header["file_info"] = *shared->m_FileInfo;
+
+	ConfigSnapshotWriter writer;
+	WriteSnapshot(writer);
+
+	const auto snapshotPath = GetConfigCachePath(path, "snapshot");
+	IFilesystem::Get().WriteFile(snapshotPath, writer.Finish(snapshotVersion, key, header.dump()), PathUsage::WriteLocal);
+	DebugLog("Saved snapshot of {} to {}", filename, snapshotPath);
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to save a snapshot of {}", filename);
+}
+
 mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesystem::path filename, std::shared_ptr<const HTTPClient> client)
 {
 	try
@@ -288,34 +563,46 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesy
 	const auto startTime = clock_t::now();
 
 	nlohmann::json json;
+	std::exception_ptr elementError;
+	std::optional<uint64_t> contentHash;
 	{
 		Log("Loading {}...", filename);
 
-		std::string file;
-		try
-		{
-			file = IFilesystem::Get().ReadFile(filename);
-		}
-		catch (...)
+		std::optional<std::string> file;
+		m_FileUnchanged = false;
+		m_SnapshotUpToDate = false;
+		if (!TryLoadSnapshot(filename, json, file, contentHash))
 		{
-			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load {}", filename);
-			co_return ConfigErrorType::ReadFileFailed;
-		}
+			try
+			{
+				if (!file)
+					file = IFilesystem::Get().ReadFile(filename);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to load {}", filename);
+				co_return ConfigErrorType::ReadFileFailed;
+			}
 
-		try
-		{
-			json = nlohmann::json::parse(file);
-		}
-		catch (...)
-		{
-			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse JSON from {}", filename);
-			co_return ConfigErrorType::JSONParseFailed;
+			try
+			{
+				json = ParseConfigJSON(*this, *file, elementError);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse JSON from {}", filename);
+				co_return ConfigErrorType::JSONParseFailed;
+			}
+
+			// Only auto-updating needs to know if the file is still what we downloaded
+			if (client)
+				contentHash = ConfigSnapshotKey::HashContents(*file);
 		}
 	}
 
 	try
 	{
-		LoadAndValidateSchema(*this, json);
+		m_LoadedSchema = LoadAndValidateSchema(*this, json);
 	}
 	catch (...)
 	{
@@ -341,12 +628,48 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesy
 		}
 	}
 
+	// Deserialize right away, before auto-updating parses another file and replaces any
+	// streamed elements. If the update succeeds, it deserializes over the top of this.
+	bool deserializeFailed = false;
+	try
+	{
+		if (elementError)
+			std::rethrow_exception(elementError);
+
+		Deserialize(json);
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to deserialize existing {}", filename);
+		deserializeFailed = true;
+	}
+
 	if (client)
 	{
 		if (auto shared = dynamic_cast<SharedConfigFileBase*>(this))
 		{
-			if (fileInfoParsed && co_await TryAutoUpdate(filename, json, *shared, *client))
+			auto updateResult = AutoUpdateResult::Skipped;
+			if (fileInfoParsed)
+				updateResult = co_await TryAutoUpdate(filename, json, *shared, *client, contentHash);
+
+			if (updateResult == AutoUpdateResult::Updated)
+			{
+				m_FileUnchanged = false;
+				m_SnapshotUpToDate = false;
+				LogConfigFileLoaded(filename, startTime);
 				co_return ConfigErrorType::Success;
+			}
+			else if (updateResult == AutoUpdateResult::NotModified)
+			{
+				// Validators are only sent while the file matches what we last wrote
+				m_FileUnchanged = true;
+			}
+			else if (updateResult == AutoUpdateResult::DeserializeFailed)
+			{
+				// Whatever the update got through is mixed in with the existing contents now, and
+				// would be saved over the file. Load the file again without the update instead.
+				co_return co_await LoadFileInternalAsync(filename, nullptr);
+			}
 		}
 	}
 	else
@@ -354,22 +677,52 @@ mh::task<std::error_condition> ConfigFileBase::LoadFileInternalAsync(std::filesy
 		DebugLog("Skipping auto-update for {} because allowAutoupdate = false.", filename);
 	}
 
-	try
+	if (deserializeFailed)
 	{
-		Deserialize(json);
-	}
-	catch (...)
-	{
-		LogException(MH_SOURCE_LOCATION_CURRENT(),
+		LogError(MH_SOURCE_LOCATION_CURRENT(),
 			"Failed to load {}, existing file failed to deserialize, and auto-update did not occur", filename);
 		co_return ConfigErrorType::DeserializeFailed;
 	}
 
-	DebugLog("Loaded {} in {} seconds", filename, to_seconds(clock_t::now() - startTime));
+	LogConfigFileLoaded(filename, startTime);
 	co_return ConfigErrorType::Success;
 }
 
 std::error_condition tf2_bot_detector::ConfigFileBase::SaveFile(const std::filesystem::path& filename) const
+{
+	// Anything queued was serialized before this, so it must not be written on top of it
+	IConfigWriter::Get().Flush();
+
+	std::string text;
+	if (auto result = SerializeToString(filename, text))
+		return result;
+
+	try
+	{
+		IFilesystem::Get().WriteFile(filename, text, PathUsage::WriteRoaming);
+	}
+	catch (...)
+	{
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", filename);
+		return ConfigErrorType::WriteFileFailed;
+	}
+
+	return ConfigErrorType::Success;
+}
+
+std::error_condition ConfigFileBase::QueueSaveFile(const std::filesystem::path& filename) const
+{
+	std::string text;
+	if (auto result = SerializeToString(filename, text))
+		return result;
+
+	IConfigWriter::Get().QueueWrite(filename, PathUsage::WriteRoaming,
+		[text = std::move(text)]() -> std::optional<std::string> { return text; });
+
+	return ConfigErrorType::Success;
+}
+
+std::error_condition ConfigFileBase::SerializeToString(const std::filesystem::path& filename, std::string& text) const
 {
 	nlohmann::json json;
 
@@ -406,16 +759,7 @@ std::error_condition tf2_bot_detector::ConfigFileBase::SaveFile(const std::files
 		return ConfigErrorType::SerializedSchemaValidationFailed;
 	}
 
-	try
-	{
-		SaveJSONToFile(filename, json);
-	}
-	catch (...)
-	{
-		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", filename);
-		return ConfigErrorType::WriteFileFailed;
-	}
-
+	text = FormatConfigJSON(json);
 	return ConfigErrorType::Success;
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "ConfigWriter.h"
 #include "Log.h"
 
 #include <mh/coroutine/task.hpp>
@@ -8,12 +9,18 @@
 #include <nlohmann/json_fwd.hpp>
 
 #include <cassert>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace tf2_bot_detector
 {
+	class ConfigSnapshotReader;
+	class ConfigSnapshotWriter;
 	class IHTTPClient;
 	class Settings;
 
@@ -91,10 +98,47 @@ namespace tf2_bot_detector
 		mh::task<std::error_condition> LoadFileAsync(const std::filesystem::path& filename, std::shared_ptr<const IHTTPClient> client = nullptr);
 		std::error_condition SaveFile(const std::filesystem::path& filename) const;
 
+		/// <summary>
+		/// Serializes on the calling thread, but leaves the write to IConfigWriter. For small files
+		/// that are saved often; large ones should serialize a copy on the writer thread instead.
+		/// </summary>
+		/// <returns>The result of serializing. Failures of the write itself are logged by IConfigWriter.</returns>
+		std::error_condition QueueSaveFile(const std::filesystem::path& filename) const;
+
+		/// <summary>
+		/// Everything SaveFile() does except the write: the file's complete new contents.
+		/// </summary>
+		std::error_condition SerializeToString(const std::filesystem::path& filename, std::string& text) const;
+
 		virtual void ValidateSchema(const ConfigSchemaInfo& schema) const {}
 		virtual void Deserialize(const nlohmann::json& json) {}
 		virtual void Serialize(nlohmann::json& json) const = 0;
 
+		/// <summary>
+		/// Files with one huge top-level array can stream it: each element is handed to
+		/// DeserializeStreamedElement() as soon as it is parsed, then dropped from the json, so
+		/// the whole file never has to be held as a DOM. The elements must be kept until the next
+		/// Deserialize() call, which should replace (not add to) the file's contents.
+		/// </summary>
+		/// <returns>The name of the streamed array, or an empty string to parse everything up front.</returns>
+		virtual std::string_view GetStreamedArrayName() const { return {}; }
+		virtual void DeserializeStreamedElement(const nlohmann::json& element) {}
+		/// <summary>
+		/// Discards any streamed elements that were not consumed by Deserialize().
+		/// </summary>
+		virtual void ResetStreamedElements() {}
+
+		/// <summary>
+		/// Streamed files can also be cached in a binary snapshot, so loading the same file again
+		/// skips parsing it. WriteSnapshot() saves the deserialized contents, and ReadSnapshot()
+		/// reads them back in place of the streamed elements. Bump the version whenever the
+		/// snapshot layout changes.
+		/// </summary>
+		/// <returns>The snapshot layout version, or 0 if this file type isn't snapshotted.</returns>
+		virtual uint32_t GetSnapshotVersion() const { return 0; }
+		virtual void WriteSnapshot(ConfigSnapshotWriter& writer) const {}
+		virtual void ReadSnapshot(ConfigSnapshotReader& reader) {}
+
 		std::optional<ConfigSchemaInfo> m_Schema;
 		// Name of the file this was loaded from, can be filename (filesystem) or "name" inside the file.
 		std::string m_FileName; 
@@ -104,6 +148,17 @@ namespace tf2_bot_detector
 
 	private:
 		mh::task<std::error_condition> LoadFileInternalAsync(std::filesystem::path filename, std::shared_ptr<const IHTTPClient> client);
+
+		bool TryLoadSnapshot(const std::filesystem::path& filename, nlohmann::json& json,
+			std::optional<std::string>& fileContents, std::optional<uint64_t>& contentHash);
+		void SaveSnapshot(const std::filesystem::path& filename) const;
+
+		// The $schema this was loaded with. Snapshots store it so they pass the same validation.
+		std::optional<ConfigSchemaInfo> m_LoadedSchema;
+		// The file on disk is byte for byte what we last saved, so there is nothing to resave
+		bool m_FileUnchanged = false;
+		// ...and the snapshot was made from it at its current last write time
+		bool m_SnapshotUpToDate = false;
 	};
 
 	class SharedConfigFileBase : public ConfigFileBase
@@ -152,23 +207,53 @@ namespace tf2_bot_detector
 
 			const auto paths = GetConfigFilePaths(GetBaseFileName());
 
-			if (!IsOfficial() && !paths.m_User.empty())
-				m_UserList = LoadConfigFileAsync<T>(paths.m_User, false, *m_Settings).get();
-
+			// Start everything that can load in the background before blocking on the user list
 			if (!paths.m_Official.empty())
 				m_OfficialList = LoadConfigFileAsync<T>(paths.m_Official, !IsOfficial(), *m_Settings);
 			else
 				m_OfficialList = mh::make_ready_task<T>();
 
-			m_ThirdPartyLists = LoadThirdPartyListsAsync(paths);
+			auto thirdPartyFiles = std::make_shared<third_party_files_type>();
+			for (const auto& file : paths.m_Others)
+				thirdPartyFiles->push_back(LoadThirdPartyFileAsync(file));
+
+			m_ThirdPartyFiles = thirdPartyFiles;
+			m_ThirdPartyLists = CombineThirdPartyListsAsync(std::move(thirdPartyFiles));
+
+			if (!IsOfficial() && !paths.m_User.empty())
+				m_UserList = LoadConfigFileAsync<T>(paths.m_User, false, *m_Settings).get();
 		}
 
-		void SaveFiles() const
+		/// <summary>
+		/// Like SaveFiles(), but copies the lists and serializes the copies on the IConfigWriter thread.
+		/// </summary>
+		void QueueSaveFiles() const
 		{
 			const T* defaultMutableList = GetDefaultMutableList();
 			const T* localList = GetLocalList();
 			if (localList)
-				localList->SaveFile(mh::format("cfg/{}.json", GetBaseFileName()));
+				QueueSaveFile(*localList, mh::format("cfg/{}.json", GetBaseFileName()));
+
+			if (defaultMutableList && defaultMutableList != localList)
+			{
+				const std::filesystem::path filename = mh::format("cfg/{}.official.json", GetBaseFileName());
+
+				if (!IsOfficial())
+					throw std::runtime_error(mh::format("Attempted to save non-official data to {}", filename));
+
+				QueueSaveFile(*defaultMutableList, filename);
+			}
+		}
+
+		/// <returns>False if any of the files failed to save.</returns>
+		bool SaveFiles() const
+		{
+			bool success = true;
+
+			const T* defaultMutableList = GetDefaultMutableList();
+			const T* localList = GetLocalList();
+			if (localList && localList->SaveFile(mh::format("cfg/{}.json", GetBaseFileName())))
+				success = false;
 
 			if (defaultMutableList && defaultMutableList != localList)
 			{
@@ -177,8 +262,11 @@ namespace tf2_bot_detector
 				if (!IsOfficial())
 					throw std::runtime_error(mh::format("Attempted to save non-official data to {}", filename));
 
-				defaultMutableList->SaveFile(filename);
+				if (defaultMutableList->SaveFile(filename))
+					success = false;
 			}
+
+			return success;
 		}
 
 		/// <summary>
@@ -238,27 +326,55 @@ namespace tf2_bot_detector
 			return retVal;
 		}
 
+		using third_party_files_type = std::vector<mh::task<std::optional<T>>>;
+
 		const Settings* m_Settings = nullptr;
 		mh::task<T> m_OfficialList;
 		std::optional<T> m_UserList;
 		mh::task<collection_type> m_ThirdPartyLists;
 
+		/// <summary>
+		/// The individual third-party files, in the same order they are combined into m_ThirdPartyLists.
+		/// Each one becomes ready as soon as it has loaded, and is std::nullopt if it failed to.
+		/// </summary>
+		std::shared_ptr<const third_party_files_type> m_ThirdPartyFiles;
+
 	private:
-		mh::task<collection_type> LoadThirdPartyListsAsync(ConfigFilePaths paths)
+		static void QueueSaveFile(const T& list, std::filesystem::path filename)
+		{
+			IConfigWriter::Get().QueueWrite(filename, PathUsage::WriteRoaming,
+				[snapshot = std::make_shared<const T>(list), filename]() -> std::optional<std::string>
+				{
+					std::string text;
+					if (snapshot->SerializeToString(filename, text))
+						return std::nullopt;
+
+					return text;
+				});
+		}
+
+		mh::task<std::optional<T>> LoadThirdPartyFileAsync(std::filesystem::path file)
+		{
+			try
+			{
+				co_return co_await LoadConfigFileAsync<T>(file, true, *m_Settings);
+			}
+			catch (...)
+			{
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Exception when loading {}", file);
+			}
+
+			co_return std::nullopt;
+		}
+
+		mh::task<collection_type> CombineThirdPartyListsAsync(std::shared_ptr<third_party_files_type> files)
 		{
 			collection_type collection;
 
-			for (const auto& file : paths.m_Others)
+			for (auto& file : *files)
 			{
-				try
-				{
-					auto parsedFile = co_await LoadConfigFileAsync<T>(file, true, *m_Settings);
-					CombineEntries(collection, parsedFile);
-				}
-				catch (...)
-				{
-					LogException(MH_SOURCE_LOCATION_CURRENT(), "Exception when loading {}", file);
-				}
+				if (const std::optional<T>& parsedFile = co_await file)
+					CombineEntries(collection, *parsedFile);
 			}
 
 			co_return collection;
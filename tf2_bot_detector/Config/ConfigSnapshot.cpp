@@ -0,0 +1,179 @@
+#include "ConfigSnapshot.h"
+
+#include <stdexcept>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	constexpr std::string_view SNAPSHOT_MAGIC = "TF2BDSNP"sv;
+
+	// Bump whenever the layout written by ConfigSnapshotWriter::Finish changes
+	constexpr uint64_t SNAPSHOT_FORMAT_VERSION = 1;
+
+	void AppendUInt(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(char((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back(char(value));
+	}
+
+	void AppendFixed64(std::string& out, uint64_t value)
+	{
+		for (int i = 0; i < 8; i++)
+			out.push_back(char((value >> (i * 8)) & 0xFF));
+	}
+
+	void AppendString(std::string& out, const std::string_view& str)
+	{
+		AppendUInt(out, str.size());
+		out.append(str);
+	}
+
+	// Zigzag, so small negative numbers stay small
+	constexpr uint64_t EncodeInt(int64_t value) { return (uint64_t(value) << 1) ^ uint64_t(value >> 63); }
+	constexpr int64_t DecodeInt(uint64_t value) { return int64_t(value >> 1) ^ -int64_t(value & 1); }
+}
+
+uint64_t ConfigSnapshotKey::HashContents(const std::string_view& contents)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325;
+	for (char c : contents)
+	{
+		hash ^= uint8_t(c);
+		hash *= 0x100000001b3;
+	}
+
+	return hash;
+}
+
+void ConfigSnapshotWriter::WriteUInt(uint64_t value)
+{
+	AppendUInt(m_Body, value);
+}
+
+void ConfigSnapshotWriter::WriteInt(int64_t value)
+{
+	AppendUInt(m_Body, EncodeInt(value));
+}
+
+void ConfigSnapshotWriter::WriteFixed64(uint64_t value)
+{
+	AppendFixed64(m_Body, value);
+}
+
+void ConfigSnapshotWriter::WriteString(const std::string_view& str)
+{
+	auto [it, inserted] = m_StringIndices.try_emplace(std::string(str), uint32_t(m_Strings.size()));
+	if (inserted)
+		m_Strings.push_back(it->first);
+
+	WriteUInt(it->second);
+}
+
+std::string ConfigSnapshotWriter::Finish(uint32_t typeVersion, const ConfigSnapshotKey& key, const std::string_view& headerJSON) const
+{
+	std::string retVal;
+	retVal.reserve(SNAPSHOT_MAGIC.size() + 64 + headerJSON.size() + m_Body.size());
+
+	retVal.append(SNAPSHOT_MAGIC);
+	AppendUInt(retVal, SNAPSHOT_FORMAT_VERSION);
+	AppendUInt(retVal, typeVersion);
+	AppendUInt(retVal, key.m_FileSize);
+	AppendUInt(retVal, EncodeInt(key.m_LastWriteTime));
+	AppendFixed64(retVal, key.m_ContentHash);
+	AppendString(retVal, headerJSON);
+
+	AppendUInt(retVal, m_Strings.size());
+	for (const auto& str : m_Strings)
+		AppendString(retVal, str);
+
+	retVal.append(m_Body);
+	return retVal;
+}
+
+ConfigSnapshotReader::ConfigSnapshotReader(const std::string_view& snapshot) :
+	m_Data(snapshot)
+{
+	if (ReadBytes(SNAPSHOT_MAGIC.size()) != SNAPSHOT_MAGIC)
+		throw std::runtime_error("Not a config snapshot");
+	if (ReadUInt() != SNAPSHOT_FORMAT_VERSION)
+		throw std::runtime_error("Unsupported config snapshot format version");
+
+	const auto typeVersion = ReadUInt();
+	if (typeVersion > UINT32_MAX)
+		throw std::runtime_error("Config snapshot type version out of range");
+
+	m_TypeVersion = uint32_t(typeVersion);
+	m_Key.m_FileSize = ReadUInt();
+	m_Key.m_LastWriteTime = ReadInt();
+	m_Key.m_ContentHash = ReadFixed64();
+	m_HeaderJSON = ReadBytes(ReadUInt());
+}
+
+void ConfigSnapshotReader::BeginBody()
+{
+	const auto count = ReadUInt();
+	if (count > m_Data.size())
+		throw std::runtime_error("Config snapshot string table is truncated");
+
+	m_Strings.clear();
+	m_Strings.reserve(size_t(count));
+	for (uint64_t i = 0; i < count; i++)
+		m_Strings.push_back(ReadBytes(ReadUInt()));
+}
+
+uint64_t ConfigSnapshotReader::ReadUInt()
+{
+	uint64_t retVal = 0;
+	for (int shift = 0; shift < 64; shift += 7)
+	{
+		const auto byte = uint8_t(ReadBytes(1)[0]);
+		retVal |= uint64_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80))
+			return retVal;
+	}
+
+	throw std::runtime_error("Config snapshot varint is too long");
+}
+
+int64_t ConfigSnapshotReader::ReadInt()
+{
+	return DecodeInt(ReadUInt());
+}
+
+uint64_t ConfigSnapshotReader::ReadFixed64()
+{
+	const auto bytes = ReadBytes(8);
+
+	uint64_t retVal = 0;
+	for (int i = 0; i < 8; i++)
+		retVal |= uint64_t(uint8_t(bytes[i])) << (i * 8);
+
+	return retVal;
+}
+
+std::string_view ConfigSnapshotReader::ReadString()
+{
+	const auto index = ReadUInt();
+	if (index >= m_Strings.size())
+		throw std::runtime_error("Config snapshot string index out of range");
+
+	return m_Strings[size_t(index)];
+}
+
+std::string_view ConfigSnapshotReader::ReadBytes(size_t count)
+{
+	if (count > m_Data.size())
+		throw std::runtime_error("Config snapshot is truncated");
+
+	const auto retVal = m_Data.substr(0, count);
+	m_Data.remove_prefix(count);
+	return retVal;
+}
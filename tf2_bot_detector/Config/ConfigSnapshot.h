@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Identifies the exact contents of the config file a snapshot was made from.
+	/// </summary>
+	struct ConfigSnapshotKey
+	{
+		uint64_t m_FileSize = 0;
+		int64_t m_LastWriteTime = 0; // std::filesystem::file_time_type ticks
+		uint64_t m_ContentHash = 0;
+
+		static uint64_t HashContents(const std::string_view& contents);
+	};
+
+	/// <summary>
+	/// Builds a binary config snapshot. Integers are written as little-endian varints, and every
+	/// string goes through a string table so repeated ones (proof, names) are only stored once.
+	/// </summary>
+	class ConfigSnapshotWriter final
+	{
+	public:
+		void WriteUInt(uint64_t value);
+		void WriteInt(int64_t value);
+		void WriteFixed64(uint64_t value);
+		void WriteString(const std::string_view& str);
+
+		/// <summary>
+		/// The complete snapshot: header, string table, then everything written so far.
+		/// </summary>
+		std::string Finish(uint32_t typeVersion, const ConfigSnapshotKey& key, const std::string_view& headerJSON) const;
+
+	private:
+		std::string m_Body;
+		std::vector<std::string_view> m_Strings;
+		std::unordered_map<std::string, uint32_t> m_StringIndices;
+	};
+
+	/// <summary>
+	/// Reads a snapshot made by ConfigSnapshotWriter. Throws std::runtime_error on anything
+	/// truncated or out of range, so a damaged snapshot just falls back to parsing the JSON.
+	/// </summary>
+	class ConfigSnapshotReader final
+	{
+	public:
+		/// <summary>
+		/// Only reads the header. The snapshot must outlive this reader.
+		/// </summary>
+		ConfigSnapshotReader(const std::string_view& snapshot);
+
+		uint32_t GetTypeVersion() const { return m_TypeVersion; }
+		const ConfigSnapshotKey& GetKey() const { return m_Key; }
+		std::string_view GetHeaderJSON() const { return m_HeaderJSON; }
+
+		/// <summary>
+		/// Reads the string table. Must be called before reading anything from the body.
+		/// </summary>
+		void BeginBody();
+
+		uint64_t ReadUInt();
+		int64_t ReadInt();
+		uint64_t ReadFixed64();
+		std::string_view ReadString();
+
+		bool IsEnd() const { return m_Data.empty(); }
+
+	private:
+		std::string_view ReadBytes(size_t count);
+
+		std::string_view m_Data;
+		uint32_t m_TypeVersion = 0;
+		ConfigSnapshotKey m_Key;
+		std::string_view m_HeaderJSON;
+		std::vector<std::string_view> m_Strings;
+	};
+}
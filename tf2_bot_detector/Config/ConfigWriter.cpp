@@ -0,0 +1,155 @@
+#include "ConfigWriter.h"
+#include "Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	class ConfigWriter final : public IConfigWriter
+	{
+	public:
+		ConfigWriter();
+		~ConfigWriter();
+
+		void QueueWrite(const std::filesystem::path& path, PathUsage usage, SerializeFunc serialize) override;
+		void Flush() override;
+
+	private:
+		using clock_type = std::chrono::steady_clock;
+
+		// Long enough to absorb things like dragging a slider in the settings window
+		static constexpr auto DEBOUNCE_TIME = 500ms;
+
+		struct PendingWrite
+		{
+			SerializeFunc m_Serialize;
+			clock_type::time_point m_DueTime;
+		};
+
+		void ThreadFunc();
+		static void Write(const std::filesystem::path& path, const SerializeFunc& serialize);
+
+		std::mutex m_Mutex;
+		std::condition_variable m_CV;
+		std::map<std::filesystem::path, PendingWrite> m_PendingWrites; // Keyed by resolved path
+		bool m_Writing = false;
+		bool m_Stop = false;
+
+		std::thread m_Thread; // Last, so everything above exists before it starts
+	};
+}
+
+IConfigWriter& IConfigWriter::Get()
+{
+	static ConfigWriter s_ConfigWriter;
+	return s_ConfigWriter;
+}
+
+ConfigWriter::ConfigWriter() :
+	m_Thread(&ConfigWriter::ThreadFunc, this)
+{
+}
+
+ConfigWriter::~ConfigWriter()
+{
+	// Anything still pending was never flushed, and logging may already be gone by now
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Stop = true;
+	}
+
+	m_CV.notify_all();
+	m_Thread.join();
+}
+
+void ConfigWriter::QueueWrite(const std::filesystem::path& path, PathUsage usage, SerializeFunc serialize)
+{
+	const auto resolvedPath = IFilesystem::Get().ResolvePath(path, usage);
+
+	{
+		std::lock_guard lock(m_Mutex);
+
+		// Keep the original due time, so a steady stream of changes still gets written regularly
+		auto [it, inserted] = m_PendingWrites.try_emplace(resolvedPath);
+		if (inserted)
+			it->second.m_DueTime = clock_type::now() + DEBOUNCE_TIME;
+
+		it->second.m_Serialize = std::move(serialize);
+	}
+
+	m_CV.notify_all();
+}
+
+void ConfigWriter::Flush()
+{
+	std::unique_lock lock(m_Mutex);
+	if (m_PendingWrites.empty() && !m_Writing)
+		return;
+
+	for (auto& [path, write] : m_PendingWrites)
+		write.m_DueTime = {};
+
+	m_CV.notify_all();
+	m_CV.wait(lock, [&] { return m_PendingWrites.empty() && !m_Writing; });
+}
+
+void ConfigWriter::ThreadFunc()
+{
+	std::unique_lock lock(m_Mutex);
+	while (!m_Stop)
+	{
+		if (m_PendingWrites.empty())
+		{
+			m_CV.wait(lock);
+			continue;
+		}
+
+		const auto next = std::min_element(m_PendingWrites.begin(), m_PendingWrites.end(),
+			[](const auto& lhs, const auto& rhs) { return lhs.second.m_DueTime < rhs.second.m_DueTime; });
+
+		if (next->second.m_DueTime > clock_type::now())
+		{
+			m_CV.wait_until(lock, next->second.m_DueTime);
+			continue;
+		}
+
+		const std::filesystem::path path = next->first;
+		const SerializeFunc serialize = std::move(next->second.m_Serialize);
+		m_PendingWrites.erase(next);
+		m_Writing = true;
+
+		lock.unlock();
+		Write(path, serialize);
+		lock.lock();
+
+		m_Writing = false;
+		m_CV.notify_all();
+	}
+}
+
+void ConfigWriter::Write(const std::filesystem::path& path, const SerializeFunc& serialize) try
+{
+	const std::optional<std::string> contents = serialize();
+	if (!contents)
+		return;
+
+	// Write next to the original, then swap it in, so there is never a half-written config file
+	auto tempPath = path;
+	tempPath += ".tmp";
+	IFilesystem::Get().WriteFile(tempPath, *contents, PathUsage::WriteRoaming);
+	std::filesystem::rename(tempPath, path);
+
+	DebugLog("Wrote {}", path);
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {}", path);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Filesystem.h"
+
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Writes config files on a background thread, so saving never blocks the UI.
+	///
+	/// Writes are held for a short debounce window, and queuing the same file again during it
+	/// replaces the pending write, so a burst of changes only writes the file once. Each file is
+	/// written to a temporary file first and renamed over the original, so a crash mid-write
+	/// can't leave it truncated.
+	/// </summary>
+	class IConfigWriter
+	{
+	public:
+		virtual ~IConfigWriter() = default;
+
+		static IConfigWriter& Get();
+
+		/// <summary>
+		/// Called on the writer thread, so it must only touch data it owns (an immutable copy).
+		/// Returns the new file contents, or std::nullopt to skip the write (after logging why).
+		/// </summary>
+		using SerializeFunc = std::function<std::optional<std::string>()>;
+
+		virtual void QueueWrite(const std::filesystem::path& path, PathUsage usage, SerializeFunc serialize) = 0;
+
+		/// <summary>
+		/// Writes everything that is queued right away, and blocks until it has been written.
+		/// Called before anything reads or synchronously writes a config file, and at shutdown.
+		/// </summary>
+		virtual void Flush() = 0;
+	};
+}
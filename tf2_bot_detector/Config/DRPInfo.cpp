@@ -47,6 +47,7 @@ void DRPInfo::DRPFile::Deserialize(const nlohmann::json& json)
 {
 	BaseClass::Deserialize(json);
 
+	m_Maps.clear();
 	auto& maps = json.at("maps");
 	for (auto it = maps.begin(); it != maps.end(); ++it)
 	{
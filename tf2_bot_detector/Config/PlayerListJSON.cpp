@@ -2,6 +2,8 @@
 #include "Networking/HTTPHelpers.h"
 #include "Util/JSONUtils.h"
 #include "ConfigHelpers.h"
+#include "ConfigSnapshot.h"
+#include "Filesystem.h"
 #include "Log.h"
 #include "Settings.h"
 
@@ -9,10 +11,13 @@
 #include <mh/text/string_insertion.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <filesystem>
 #include <iomanip>
+#include <limits>
 #include <regex>
 #include <string>
+#include <utility>
 
 using namespace tf2_bot_detector;
 using namespace std::string_literals;
@@ -20,6 +25,12 @@ using namespace std::string_view_literals;
 
 static std::filesystem::path s_PlayerListPath("cfg/playerlist.json");
 
+// Not *.json, so it isn't picked up as a third-party player list
+static std::filesystem::path s_PlayerListJournalPath("cfg/playerlist.journal");
+
+// Fold the journal back into playerlist.json once it has this many records
+static constexpr size_t PLAYERLIST_JOURNAL_COMPACT_THRESHOLD = 256;
+
 namespace tf2_bot_detector
 {
 	std::string to_string(const PlayerAttribute& d)
@@ -133,7 +144,14 @@ namespace tf2_bot_detector
 		if (auto lastSeen = j.find("last_seen"); lastSeen != j.end())
 			lastSeen->get_to(d.m_LastSeen.emplace());
 
-		try_get_to_defaulted(j, d.m_Proof, "proof");
+		d.m_Proof.clear();
+		if (auto proof = j.find("proof"); proof != j.end())
+		{
+			// The schema allows anything in here, but everything we display or write is a string
+			d.m_Proof.reserve(proof->size());
+			for (const auto& entry : *proof)
+				d.m_Proof.push_back(entry.is_string() ? entry.get<std::string>() : entry.dump());
+		}
 	}
 	catch (...)
 	{
@@ -163,6 +181,21 @@ PlayerListJSON::PlayerListJSON(const Settings& settings) :
 	LoadFiles();
 }
 
+PlayerListJSON::~PlayerListJSON()
+{
+	if (m_JournalRecordCount > 0)
+	{
+		try
+		{
+			CompactJournal();
+		}
+		catch (...)
+		{
+			LogException("Failed to save {} on exit, changes are still in {}", s_PlayerListPath, s_PlayerListJournalPath);
+		}
+	}
+}
+
 void PlayerListJSON::PlayerListFile::ValidateSchema(const ConfigSchemaInfo& schema) const
 {
 	if (schema.m_Type != "playerlist")
@@ -175,14 +208,25 @@ void PlayerListJSON::PlayerListFile::Deserialize(const nlohmann::json& json)
 {
 	SharedConfigFileBase::Deserialize(json);
 
-	PlayerMap_t& map = m_Players;
+	// Anything streamed out while parsing has already been removed from json
+	m_Players = std::move(m_StreamedPlayers);
+	m_StreamedPlayers = {};
+
 	for (const auto& player : json.at("players"))
-	{
-		const SteamID steamID = player.at("steamid");
-		PlayerListData parsed(steamID);
-		player.get_to(parsed);
-		map.emplace(steamID, std::move(parsed));
-	}
+		DeserializePlayer(m_Players, player);
+}
+
+void PlayerListJSON::PlayerListFile::DeserializeStreamedElement(const nlohmann::json& element)
+{
+	DeserializePlayer(m_StreamedPlayers, element);
+}
+
+void PlayerListJSON::PlayerListFile::DeserializePlayer(PlayerMap_t& map, const nlohmann::json& player)
+{
+	const SteamID steamID = player.at("steamid");
+	PlayerListData parsed(steamID);
+	player.get_to(parsed);
+	map.emplace(steamID, std::move(parsed));
 }
 
 void PlayerListJSON::PlayerListFile::Serialize(nlohmann::json& json) const
@@ -204,6 +248,62 @@ void PlayerListJSON::PlayerListFile::Serialize(nlohmann::json& json) const
 	}
 }
 
+void PlayerListJSON::PlayerListFile::WriteSnapshot(ConfigSnapshotWriter& writer) const
+{
+	// Same players as Serialize(), so the snapshot matches the resaved file
+	const auto savedCount = std::count_if(m_Players.begin(), m_Players.end(),
+		[](const auto& pair) { return !pair.second.m_SavedAttributes.empty(); });
+	writer.WriteUInt(savedCount);
+
+	for (const auto& [steamID, player] : m_Players)
+	{
+		if (player.m_SavedAttributes.empty())
+			continue;
+
+		writer.WriteFixed64(steamID.ID64);
+		writer.WriteUInt(player.m_SavedAttributes.GetBits().to_ullong());
+
+		writer.WriteUInt(player.m_LastSeen ? 1 : 0);
+		if (player.m_LastSeen)
+		{
+			writer.WriteInt(std::chrono::duration_cast<std::chrono::seconds>(player.m_LastSeen->m_Time.time_since_epoch()).count());
+			writer.WriteString(player.m_LastSeen->m_PlayerName);
+		}
+
+		writer.WriteUInt(player.m_Proof.size());
+		for (const auto& proof : player.m_Proof)
+			writer.WriteString(proof);
+	}
+}
+
+void PlayerListJSON::PlayerListFile::ReadSnapshot(ConfigSnapshotReader& reader)
+{
+	const auto count = reader.ReadUInt();
+	for (uint64_t i = 0; i < count; i++)
+	{
+		const SteamID steamID(reader.ReadFixed64());
+		PlayerListData player(steamID);
+		player.m_SavedAttributes = PlayerAttributesList(PlayerAttributesList::bits_t(reader.ReadUInt()));
+
+		if (reader.ReadUInt())
+		{
+			auto& lastSeen = player.m_LastSeen.emplace();
+			lastSeen.m_Time = std::chrono::system_clock::time_point(std::chrono::seconds(reader.ReadInt()));
+			lastSeen.m_PlayerName = reader.ReadString();
+		}
+
+		const auto proofCount = reader.ReadUInt();
+		for (uint64_t p = 0; p < proofCount; p++)
+			player.m_Proof.emplace_back(reader.ReadString());
+
+		// Written in map order, so every insert goes at the end
+		m_StreamedPlayers.emplace_hint(m_StreamedPlayers.end(), steamID, std::move(player));
+	}
+
+	if (!reader.IsEnd())
+		throw std::runtime_error("Unexpected data at the end of the player list snapshot");
+}
+
 PlayerListData& PlayerListJSON::PlayerListFile::GetOrAddPlayer(const SteamID& id)
 {
 	if (auto found = m_Players.find(id); found != m_Players.end())
@@ -226,15 +326,20 @@ bool PlayerListJSON::LoadFiles()
 		}
 
 		if (action != ModifyPlayerAction::NoChanges)
-			m_CFGGroup.SaveFiles();
+			m_CFGGroup.QueueSaveFiles();
+	}
+	else
+	{
+		ReplayJournal();
 	}
 
+	m_IndexValid = false;
 	return true;
 }
 
 void PlayerListJSON::SaveFiles() const
 {
-	m_CFGGroup.SaveFiles();
+	m_CFGGroup.QueueSaveFiles();
 }
 
 auto PlayerListJSON::FindPlayerData(const SteamID& id) const ->
@@ -248,12 +353,17 @@ auto PlayerListJSON::FindPlayerData(const SteamID& id) const ->
 			co_yield { m_CFGGroup.m_UserList->GetName(), found->second };
 		}
 	}
-	if (auto list = m_CFGGroup.m_ThirdPartyLists.try_get())
+	if (m_CFGGroup.m_ThirdPartyFiles)
 	{
-		for (auto& file : *list)
+		for (const auto& task : *m_CFGGroup.m_ThirdPartyFiles)
 		{
-			if (auto found = file.second.find(id); found != file.second.end())
-				co_yield { file.first, found->second };
+			// Each file shows up as soon as it has loaded, rather than waiting on all of them
+			const auto file = task.try_get();
+			if (!file || !*file)
+				continue;
+
+			if (auto found = (*file)->m_Players.find(id); found != (*file)->m_Players.end())
+				co_yield { (*file)->GetName(), found->second };
 		}
 	}
 	if (auto list = m_CFGGroup.m_OfficialList.try_get())
@@ -297,11 +407,13 @@ PlayerMarks PlayerListJSON::GetPlayerAttributes(const SteamID& id) const
 	if (id == m_Settings->GetLocalSteamID())
 		return {};
 
+	const PlayerListIndex& index = GetIndex();
+
 	PlayerMarks marks;
-	for (const auto& [file, found] : FindPlayerAttributes(id))
+	for (const auto& mark : index.FindPlayer(id))
 	{
-		if (found)
-			marks.m_Marks.push_back({ found, file });
+		if (auto attr = mark.GetAttributes())
+			marks.m_Marks.push_back({ attr, index.GetFileName(mark.m_FileID) });
 	}
 
 	return marks;
@@ -325,17 +437,48 @@ PlayerMarks PlayerListJSON::HasPlayerAttributes(const SteamID& id, const PlayerA
 	if (id == m_Settings->GetLocalSteamID())
 		return {};
 
+	const PlayerListIndex& index = GetIndex();
+
 	PlayerMarks marks;
-	for (const auto& [file, found] : FindPlayerAttributes(id, persistence))
+	for (const auto& mark : index.FindPlayer(id))
 	{
-		auto attr = found & attributes;
+		auto attr = mark.GetAttributes(persistence) & attributes;
 		if (attr)
-			marks.m_Marks.push_back({ attr, file });
+			marks.m_Marks.push_back({ attr, index.GetFileName(mark.m_FileID) });
 	}
 
 	return marks;
 }
 
+MarkedPlayerCounts PlayerListJSON::CountMarkedPlayers(const std::unordered_set<SteamID>& ids) const
+{
+	const PlayerListIndex& index = GetIndex();
+	const SteamID localSteamID = m_Settings->GetLocalSteamID();
+
+	MarkedPlayerCounts counts;
+	for (const SteamID& id : ids)
+	{
+		if (id == localSteamID)
+			continue;
+
+		PlayerAttributesList attributes;
+		for (const auto& mark : index.FindPlayer(id))
+			attributes |= mark.GetAttributes();
+
+		if (!attributes)
+			continue;
+
+		counts.m_MarkedCount++;
+		for (size_t i = 0; i < counts.m_AttributeCounts.size(); i++)
+		{
+			if (attributes.HasAttribute(PlayerAttribute(i)))
+				counts.m_AttributeCounts[i]++;
+		}
+	}
+
+	return counts;
+}
+
 ModifyPlayerResult PlayerListJSON::ModifyPlayer(const SteamID& id,
 	const std::function<ModifyPlayerAction(PlayerListData& data)>& func)
 {
@@ -363,7 +506,13 @@ ModifyPlayerResult PlayerListJSON::ModifyPlayer(const SteamID& id,
 	{
 		OnPlayerDataChanged(defaultMutableData);
 		defaultMutableDataRef = defaultMutableData;
-		SaveFiles();
+		UpdateIndex(id);
+
+		if (m_CFGGroup.IsOfficial())
+			SaveFiles();
+		else
+			AppendToJournal(defaultMutableDataRef);
+
 		return ModifyPlayerResult::FileSaved;
 	}
 	else if (action == ModifyPlayerAction::NoChanges)
@@ -376,6 +525,94 @@ ModifyPlayerResult PlayerListJSON::ModifyPlayer(const SteamID& id,
 	}
 }
 
+void PlayerListJSON::AppendToJournal(const PlayerListData& data)
+{
+	try
+	{
+		IFilesystem::Get().AppendFile(s_PlayerListJournalPath, nlohmann::json(data).dump() << '\n', PathUsage::WriteRoaming);
+	}
+	catch (...)
+	{
+		LogException("Failed to append to {}, saving {} instead", s_PlayerListJournalPath, s_PlayerListPath);
+		CompactJournal();
+		return;
+	}
+
+	if (++m_JournalRecordCount >= PLAYERLIST_JOURNAL_COMPACT_THRESHOLD)
+		CompactJournal();
+}
+
+void PlayerListJSON::ReplayJournal()
+{
+	m_JournalRecordCount = 0;
+
+	std::string journal;
+	try
+	{
+		if (!IFilesystem::Get().Exists(s_PlayerListJournalPath))
+			return;
+
+		journal = IFilesystem::Get().ReadFile(s_PlayerListJournalPath);
+	}
+	catch (...)
+	{
+		LogException("Failed to read {}", s_PlayerListJournalPath);
+		return;
+	}
+
+	// Each record is the complete new state of one player, so later ones simply win
+	auto& localList = m_CFGGroup.GetLocalList();
+	size_t recordCount = 0;
+	for (std::string_view remaining = journal; !remaining.empty(); )
+	{
+		const auto lineEnd = remaining.find('\n');
+		const auto line = remaining.substr(0, lineEnd);
+		remaining.remove_prefix(lineEnd == remaining.npos ? remaining.size() : lineEnd + 1);
+
+		if (line.empty())
+			continue;
+
+		try
+		{
+			const auto json = nlohmann::json::parse(line);
+			const SteamID steamID = json.at("steamid");
+			PlayerListData data(steamID);
+			json.get_to(data);
+			localList.GetOrAddPlayer(steamID) = std::move(data);
+			recordCount++;
+		}
+		catch (...)
+		{
+			// Most likely the last record, cut off by a crash while it was being written
+			LogException("Skipping damaged record in {}", s_PlayerListJournalPath);
+		}
+	}
+
+	Log("Replayed {} change(s) from {}", recordCount, s_PlayerListJournalPath);
+	CompactJournal();
+}
+
+void PlayerListJSON::CompactJournal()
+{
+	// Only throw the journal away once everything in it is safely in playerlist.json
+	if (!m_CFGGroup.SaveFiles())
+	{
+		LogError("Failed to save {}, keeping {}", s_PlayerListPath, s_PlayerListJournalPath);
+		return;
+	}
+
+	try
+	{
+		std::filesystem::remove(IFilesystem::Get().ResolvePath(s_PlayerListJournalPath, PathUsage::WriteRoaming));
+	}
+	catch (...)
+	{
+		LogException("Failed to remove {}", s_PlayerListJournalPath);
+	}
+
+	m_JournalRecordCount = 0;
+}
+
 ModifyPlayerAction PlayerListJSON::OnPlayerDataChanged(PlayerListData& data)
 {
 	ModifyPlayerAction retVal = ModifyPlayerAction::NoChanges;
@@ -400,6 +637,97 @@ ModifyPlayerAction PlayerListJSON::OnPlayerDataChanged(PlayerListData& data)
 	return retVal;
 }
 
+const PlayerListIndex& PlayerListJSON::GetIndex() const
+{
+	const PlayerListFile* userList = m_CFGGroup.GetLocalList();
+	const auto& thirdPartyFiles = m_CFGGroup.m_ThirdPartyFiles;
+	const size_t thirdPartyFileCount = thirdPartyFiles ? thirdPartyFiles->size() : 0;
+
+	const auto AddPlayers = [&](PlayerListIndex::FileID file, const PlayerListFile& list)
+	{
+		m_Index.SetFileName(file, list.GetName());
+		for (const auto& [id, data] : list.m_Players)
+			m_Index.SetPlayer(file, data);
+	};
+
+	if (!m_IndexValid || m_IndexedUserFile.has_value() != (userList != nullptr))
+	{
+		// Every file gets its ID up front, in FindPlayerData order, so the others can be
+		// added in whatever order they finish loading
+		m_Index.Clear();
+
+		m_IndexedUserFile.reset();
+		if (userList)
+		{
+			m_IndexedUserFile = m_Index.AddFile({});
+			AddPlayers(*m_IndexedUserFile, *userList);
+		}
+
+		m_FirstThirdPartyFile = PlayerListIndex::FileID(m_Index.GetFileCount());
+		for (size_t i = 0; i < thirdPartyFileCount; i++)
+			m_Index.AddFile({});
+
+		m_IndexedOfficialFile = m_Index.AddFile({});
+
+		m_IndexedThirdPartyFiles.assign(thirdPartyFileCount, false);
+		m_IndexedThirdPartyFileCount = 0;
+		m_IndexedOfficialList = false;
+		m_IndexValid = true;
+	}
+
+	if (!m_IndexedOfficialList)
+	{
+		if (auto list = m_CFGGroup.m_OfficialList.try_get())
+		{
+			AddPlayers(m_IndexedOfficialFile, *list);
+			m_IndexedOfficialList = true;
+		}
+	}
+
+	for (size_t i = 0; m_IndexedThirdPartyFileCount < thirdPartyFileCount && i < thirdPartyFileCount; i++)
+	{
+		if (m_IndexedThirdPartyFiles[i])
+			continue;
+
+		if (auto file = (*thirdPartyFiles)[i].try_get())
+		{
+			if (*file)
+				AddPlayers(PlayerListIndex::FileID(m_FirstThirdPartyFile + i), **file);
+
+			m_IndexedThirdPartyFiles[i] = true;
+			m_IndexedThirdPartyFileCount++;
+		}
+	}
+
+	return m_Index;
+}
+
+void PlayerListJSON::UpdateIndex(const SteamID& id)
+{
+	// If the local list was only just created, GetIndex() will notice and rebuild everything
+	if (!m_IndexValid || m_IndexedUserFile.has_value() != m_CFGGroup.m_UserList.has_value())
+		return;
+
+	// ModifyPlayer only ever touches the local and official lists
+	const auto Update = [&](PlayerListIndex::FileID file, const PlayerListFile& list)
+	{
+		if (auto found = list.m_Players.find(id); found != list.m_Players.end())
+			m_Index.SetPlayer(file, found->second);
+		else
+			m_Index.SetPlayer(file, PlayerListData(id));
+	};
+
+	if (m_IndexedUserFile)
+		Update(*m_IndexedUserFile, *m_CFGGroup.m_UserList);
+
+	// Otherwise it'll be indexed in full once GetIndex() sees it has loaded
+	if (m_IndexedOfficialList)
+	{
+		if (auto list = m_CFGGroup.m_OfficialList.try_get())
+			Update(m_IndexedOfficialFile, *list);
+	}
+}
+
 PlayerListData::PlayerListData(const SteamID& id) :
 	m_SteamID(id)
 {
@@ -417,7 +745,7 @@ void tf2_bot_detector::PlayerListData::addProof(std::string reason)
 bool tf2_bot_detector::PlayerListData::proofExists(std::string reason)
 {
 	bool found = false;
-	for (auto p : m_Proof) {
+	for (const auto& p : m_Proof) {
 		if (p == reason) {
 			found = true;
 			break;
@@ -478,9 +806,9 @@ bool PlayerAttributesList::SetAttribute(PlayerAttribute attribute, bool set)
 	}
 }
 
-void PlayerListJSON::ConfigFileGroup::CombineEntries(BaseClass::collection_type& map, const PlayerListFile& file) const
+void PlayerListJSON::ConfigFileGroup::CombineEntries(BaseClass::collection_type& count, const PlayerListFile& file) const
 {
-	map.push_back({ file.GetName(), file.m_Players });
+	count.m_Count += file.size();
 }
 
 bool PlayerMarks::Has(const PlayerAttributesList& attr) const
@@ -493,3 +821,136 @@ bool PlayerMarks::Has(const PlayerAttributesList& attr) const
 
 	return false;
 }
+
+PlayerAttributesList PlayerListIndex::Mark::GetAttributes(AttributePersistence persistence) const
+{
+	using bits_t = PlayerAttributesList::bits_t;
+
+	switch (persistence)
+	{
+	default:
+		LogError("Unknown persistence {}", mh::enum_fmt(persistence));
+		[[fallthrough]];
+	case AttributePersistence::Any:
+		return PlayerAttributesList(bits_t(m_SavedBits | m_TransientBits));
+	case AttributePersistence::Saved:
+		return PlayerAttributesList(bits_t(m_SavedBits));
+	case AttributePersistence::Transient:
+		return PlayerAttributesList(bits_t(m_TransientBits));
+	}
+}
+
+void PlayerListIndex::Clear()
+{
+	m_FileNames.clear();
+	m_Players.clear();
+	m_Version++;
+}
+
+auto PlayerListIndex::AddFile(const ConfigFileName& name) -> FileID
+{
+	if (m_FileNames.size() > std::numeric_limits<FileID>::max())
+		throw std::length_error("Too many player list files");
+
+	m_FileNames.push_back(name);
+	return FileID(m_FileNames.size() - 1);
+}
+
+void PlayerListIndex::SetPlayer(FileID file, const PlayerListData& data)
+{
+	static_assert(PlayerAttributesList::size() <= 8, "Mark attribute bits are stored in a uint8_t");
+
+	Mark mark;
+	mark.m_FileID = file;
+	mark.m_SavedBits = uint8_t(data.m_SavedAttributes.GetBits().to_ulong());
+	mark.m_TransientBits = uint8_t(data.m_TransientAttributes.GetBits().to_ulong());
+
+	m_Version++;
+	if (mark.m_SavedBits || mark.m_TransientBits)
+	{
+		m_Players[data.GetSteamID()].SetMark(mark);
+	}
+	else if (auto found = m_Players.find(data.GetSteamID()); found != m_Players.end())
+	{
+		found->second.RemoveMark(file);
+		if (found->second.empty())
+			m_Players.erase(found);
+	}
+}
+
+auto PlayerListIndex::FindPlayer(const SteamID& id) const -> std::span<const Mark>
+{
+	if (auto found = m_Players.find(id); found != m_Players.end())
+		return found->second.GetMarks();
+
+	return {};
+}
+
+auto PlayerListIndex::Entry::GetMarks() const -> std::span<const Mark>
+{
+	if (!m_Overflow.empty())
+		return m_Overflow;
+
+	return { m_Inline.data(), m_InlineCount };
+}
+
+void PlayerListIndex::Entry::SetMark(const Mark& mark)
+{
+	const auto CompareFileID = [](const Mark& lhs, FileID rhs) { return lhs.m_FileID < rhs; };
+
+	if (m_Overflow.empty())
+	{
+		Mark* const end = m_Inline.data() + m_InlineCount;
+		Mark* const it = std::lower_bound(m_Inline.data(), end, mark.m_FileID, CompareFileID);
+		if (it != end && it->m_FileID == mark.m_FileID)
+		{
+			*it = mark;
+			return;
+		}
+
+		if (m_InlineCount < m_Inline.size())
+		{
+			std::move_backward(it, end, end + 1);
+			*it = mark;
+			m_InlineCount++;
+			return;
+		}
+
+		m_Overflow.assign(m_Inline.data(), end);
+		m_InlineCount = 0;
+	}
+
+	const auto it = std::lower_bound(m_Overflow.begin(), m_Overflow.end(), mark.m_FileID, CompareFileID);
+	if (it != m_Overflow.end() && it->m_FileID == mark.m_FileID)
+		*it = mark;
+	else
+		m_Overflow.insert(it, mark);
+}
+
+void PlayerListIndex::Entry::RemoveMark(FileID file)
+{
+	const auto IsFile = [&](const Mark& mark) { return mark.m_FileID == file; };
+
+	if (m_Overflow.empty())
+	{
+		Mark* const end = m_Inline.data() + m_InlineCount;
+		Mark* const it = std::find_if(m_Inline.data(), end, IsFile);
+		if (it != end)
+		{
+			std::move(it + 1, end, it);
+			m_InlineCount--;
+		}
+
+		return;
+	}
+
+	if (const auto it = std::find_if(m_Overflow.begin(), m_Overflow.end(), IsFile); it != m_Overflow.end())
+		m_Overflow.erase(it);
+
+	if (m_Overflow.size() <= m_Inline.size())
+	{
+		std::copy(m_Overflow.begin(), m_Overflow.end(), m_Inline.begin());
+		m_InlineCount = uint8_t(m_Overflow.size());
+		m_Overflow = {};
+	}
+}
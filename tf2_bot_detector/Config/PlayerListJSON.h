@@ -7,11 +7,16 @@
 #include <mh/coroutine/generator.hpp>
 #include <nlohmann/json_fwd.hpp>
 
+#include <array>
 #include <bitset>
 #include <chrono>
+#include <cstdint>
 #include <filesystem>
 #include <map>
 #include <optional>
+#include <span>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace tf2_bot_detector
 {
@@ -71,6 +76,8 @@ namespace tf2_bot_detector
 		std::size_t count() const { return m_Bits.count(); }
 		explicit operator bool() const { return m_Bits.any(); }
 
+		const bits_t& GetBits() const { return m_Bits; }
+
 	private:
 		bits_t m_Bits;
 	};
@@ -107,8 +114,7 @@ namespace tf2_bot_detector
 		};
 		std::optional<LastSeen> m_LastSeen;
 
-		// TODO: vector<std::string>
-		std::vector<nlohmann::json> m_Proof;
+		std::vector<std::string> m_Proof;
 		void addProof(std::string reason);
 		bool proofExists(std::string reason);
 
@@ -167,10 +173,88 @@ namespace tf2_bot_detector
 		std::vector<Mark> m_Marks;
 	};
 
+	struct MarkedPlayerCounts final
+	{
+		std::array<uint32_t, size_t(PlayerAttribute::COUNT)> m_AttributeCounts{};
+		uint32_t m_MarkedCount = 0; // Players with at least one attribute
+
+		uint32_t GetCount(PlayerAttribute attribute) const { return m_AttributeCounts[size_t(attribute)]; }
+	};
+
+	/// <summary>
+	/// Merged view of every loaded player list, keyed by SteamID, so attribute lookups are a
+	/// single hash probe instead of a search through each file's map in turn. Players without
+	/// any attributes are not indexed.
+	/// </summary>
+	class PlayerListIndex final
+	{
+	public:
+		using FileID = uint16_t;
+
+		struct Mark
+		{
+			FileID m_FileID = 0;
+			uint8_t m_SavedBits = 0;
+			uint8_t m_TransientBits = 0;
+
+			PlayerAttributesList GetAttributes(AttributePersistence persistence = AttributePersistence::Any) const;
+		};
+
+		void Clear();
+
+		/// <summary>
+		/// Files must be added in the order their marks should be reported in.
+		/// </summary>
+		FileID AddFile(const ConfigFileName& name);
+		void SetFileName(FileID file, const ConfigFileName& name) { m_FileNames.at(file) = name; }
+		const ConfigFileName& GetFileName(FileID file) const { return m_FileNames.at(file); }
+		size_t GetFileCount() const { return m_FileNames.size(); }
+
+		/// <summary>
+		/// Adds or replaces this player's mark for the given file, or removes it if data has no attributes.
+		/// </summary>
+		void SetPlayer(FileID file, const PlayerListData& data);
+
+		/// <returns>This player's marks in every file that has any, ordered by FileID.</returns>
+		std::span<const Mark> FindPlayer(const SteamID& id) const;
+
+		size_t size() const { return m_Players.size(); }
+
+		/// <summary>
+		/// Incremented every time the contents of the index change.
+		/// </summary>
+		uint64_t GetVersion() const { return m_Version; }
+
+	private:
+		static constexpr size_t INLINE_MARK_COUNT = 3;
+
+		/// <summary>
+		/// Almost every player is only in one or two files, so marks are stored inline until
+		/// there are more than INLINE_MARK_COUNT of them.
+		/// </summary>
+		struct Entry
+		{
+			std::span<const Mark> GetMarks() const;
+			void SetMark(const Mark& mark);
+			void RemoveMark(FileID file);
+			bool empty() const { return m_InlineCount == 0 && m_Overflow.empty(); }
+
+		private:
+			std::array<Mark, INLINE_MARK_COUNT> m_Inline{};
+			uint8_t m_InlineCount = 0;
+			std::vector<Mark> m_Overflow; // Holds all the marks once spilled
+		};
+
+		std::vector<ConfigFileName> m_FileNames;
+		std::unordered_map<SteamID, Entry> m_Players;
+		uint64_t m_Version = 0;
+	};
+
 	class PlayerListJSON final
 	{
 	public:
 		PlayerListJSON(const Settings& settings);
+		~PlayerListJSON();
 
 		bool LoadFiles();
 		void SaveFiles() const;
@@ -186,6 +270,18 @@ namespace tf2_bot_detector
 		ModifyPlayerResult ModifyPlayer(const SteamID& id,
 			const std::function<ModifyPlayerAction(PlayerListData& data)>& func);
 
+		/// <summary>
+		/// Counts how many of the given players have each attribute, in any file. Equivalent to
+		/// calling GetPlayerAttributes() on each of them, without building any PlayerMarks.
+		/// </summary>
+		MarkedPlayerCounts CountMarkedPlayers(const std::unordered_set<SteamID>& ids) const;
+
+		/// <summary>
+		/// Changes whenever any player's attributes might have changed, so results derived from
+		/// them can be cached until then.
+		/// </summary>
+		uint64_t GetMarksVersion() const { return GetIndex().GetVersion(); }
+
 		size_t GetPlayerCount() const { return m_CFGGroup.size(); }
 
 	private:
@@ -193,6 +289,31 @@ namespace tf2_bot_detector
 
 		ModifyPlayerAction OnPlayerDataChanged(PlayerListData& data);
 
+		/// <summary>
+		/// Marking a player appends their new data to cfg/playerlist.journal instead of rewriting
+		/// all of playerlist.json. The journal is folded back into playerlist.json (and deleted)
+		/// once it gets long, whenever the lists are loaded, and on exit.
+		/// </summary>
+		void AppendToJournal(const PlayerListData& data);
+		void ReplayJournal();
+		void CompactJournal();
+		size_t m_JournalRecordCount = 0;
+
+		/// <summary>
+		/// Adds any lists that finished loading since the last call to the index, or rebuilds it after a reload.
+		/// </summary>
+		const PlayerListIndex& GetIndex() const;
+		void UpdateIndex(const SteamID& id);
+
+		mutable PlayerListIndex m_Index;
+		mutable bool m_IndexValid = false;
+		mutable std::optional<PlayerListIndex::FileID> m_IndexedUserFile;
+		mutable PlayerListIndex::FileID m_IndexedOfficialFile = 0;
+		mutable bool m_IndexedOfficialList = false;
+		mutable PlayerListIndex::FileID m_FirstThirdPartyFile = 0;
+		mutable std::vector<bool> m_IndexedThirdPartyFiles;
+		mutable size_t m_IndexedThirdPartyFileCount = 0;
+
 		using PlayerMap_t = std::map<SteamID, PlayerListData>;
 
 		struct PlayerListFile final : public SharedConfigFileBase
@@ -201,16 +322,39 @@ namespace tf2_bot_detector
 			void Deserialize(const nlohmann::json& json) override;
 			void Serialize(nlohmann::json& json) const override;
 
+			std::string_view GetStreamedArrayName() const override { return "players"; }
+			void DeserializeStreamedElement(const nlohmann::json& element) override;
+			void ResetStreamedElements() override { m_StreamedPlayers = {}; }
+
+			uint32_t GetSnapshotVersion() const override { return 1; }
+			void WriteSnapshot(ConfigSnapshotWriter& writer) const override;
+			void ReadSnapshot(ConfigSnapshotReader& reader) override;
+
 			size_t size() const { return m_Players.size(); }
 
 			PlayerListData& GetOrAddPlayer(const SteamID& id);
 
 			PlayerMap_t m_Players;
+
+		private:
+			static void DeserializePlayer(PlayerMap_t& map, const nlohmann::json& player);
+
+			PlayerMap_t m_StreamedPlayers; // Parsed, but not yet committed to m_Players by Deserialize()
 		};
 
 		static constexpr int PLAYERLIST_SCHEMA_VERSION = 3;
 
-		struct ConfigFileGroup final : public ConfigFileGroupBase<PlayerListFile, std::vector<std::pair<ConfigFileName, PlayerMap_t>>>
+		/// <summary>
+		/// Third-party players are looked up in each file's own task (ConfigFileGroup::m_ThirdPartyFiles),
+		/// so combining the files only needs to count them rather than copy every map.
+		/// </summary>
+		struct ThirdPartyPlayerCount final
+		{
+			size_t m_Count = 0;
+			size_t size() const { return m_Count; }
+		};
+
+		struct ConfigFileGroup final : public ConfigFileGroupBase<PlayerListFile, ThirdPartyPlayerCount>
 		{
 			using BaseClass = ConfigFileGroupBase;
 
@@ -5,6 +5,7 @@
 #include "Log.h"
 #include "PlayerListJSON.h"
 #include "Settings.h"
+#include "Util/TextScanner.h"
 
 #include <mh/text/case_insensitive_string.hpp>
 #include <mh/text/string_insertion.hpp>
@@ -12,6 +13,7 @@
 #include <mh/utility.hpp>
 #include <nlohmann/json.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <regex>
 #include <stdexcept>
@@ -210,12 +212,13 @@ ModerationRules::ModerationRules(const Settings& settings) :
 bool ModerationRules::LoadFiles()
 {
 	m_CFGGroup.LoadFiles();
+	m_CompiledRules.reset();
 	return true;
 }
 
 bool ModerationRules::SaveFile() const
 {
-	m_CFGGroup.SaveFiles();
+	m_CFGGroup.QueueSaveFiles();
 	return true;
 }
 
@@ -240,6 +243,27 @@ mh::generator<const ModerationRule&> tf2_bot_detector::ModerationRules::GetRules
 	}
 }
 
+std::shared_ptr<const CompiledModerationRules> ModerationRules::GetCompiledRules() const
+{
+	const bool officialListLoaded = m_CFGGroup.m_OfficialList.try_get() != nullptr;
+	const bool thirdPartyListsLoaded = m_CFGGroup.m_ThirdPartyLists.try_get() != nullptr;
+
+	if (!m_CompiledRules ||
+		m_CompiledOfficialList != officialListLoaded ||
+		m_CompiledThirdPartyLists != thirdPartyListsLoaded)
+	{
+		std::vector<ModerationRule> rules;
+		for (const ModerationRule& rule : GetRules())
+			rules.push_back(rule);
+
+		m_CompiledRules = std::make_shared<const CompiledModerationRules>(std::move(rules));
+		m_CompiledOfficialList = officialListLoaded;
+		m_CompiledThirdPartyLists = thirdPartyListsLoaded;
+	}
+
+	return m_CompiledRules;
+}
+
 void ModerationRules::RuleFile::ValidateSchema(const ConfigSchemaInfo& schema) const
 {
 	if (schema.m_Type != "rules")
@@ -368,6 +392,123 @@ catch (...)
 	throw;
 }
 
+CompiledTextMatch::CompiledTextMatch(const TextMatch& match) :
+	m_Mode(match.m_Mode), m_CaseSensitive(match.m_CaseSensitive)
+{
+	if (m_Mode == TextMatchMode::Regex)
+	{
+		std::regex_constants::syntax_option_type options = std::regex_constants::optimize;
+		if (!m_CaseSensitive)
+			options |= std::regex_constants::icase;
+
+		for (const auto& pattern : match.m_Patterns)
+		{
+			try
+			{
+				m_Regexes.emplace_back(pattern, options);
+			}
+			catch (const std::regex_error&)
+			{
+				LogException("Regex error when trying to compile pattern {}", std::quoted(pattern));
+			}
+		}
+
+		return;
+	}
+
+	for (const auto& pattern : match.m_Patterns)
+	{
+		if (pattern.empty())
+		{
+			m_HasEmptyPattern = true;
+			continue;
+		}
+
+		// Words are runs of \w, so anything else can never match
+		if (m_Mode == TextMatchMode::Word && !std::all_of(pattern.begin(), pattern.end(), &TextScanner::IsWordChar))
+			continue;
+
+		m_Matcher.AddPattern(pattern);
+		m_Patterns.push_back(pattern);
+		m_MaxPatternLength = std::max(m_MaxPatternLength, pattern.size());
+	}
+
+	m_Matcher.Build();
+}
+
+template<typename TFunc>
+bool CompiledTextMatch::AnyMatch(const std::string_view& text, TFunc&& isAccepted) const
+{
+	bool found = false;
+	m_Matcher.FindAll(text, [&](MultiPatternMatcher::PatternID id, size_t begin, size_t end)
+		{
+			// The automaton is case-insensitive
+			if (m_CaseSensitive && text.substr(begin, end - begin) != m_Patterns[id])
+				return true;
+
+			found = isAccepted(begin, end);
+			return !found;
+		});
+
+	return found;
+}
+
+bool CompiledTextMatch::Match(const std::string_view& text) const
+{
+	switch (m_Mode)
+	{
+	case TextMatchMode::Regex:
+		return std::any_of(m_Regexes.begin(), m_Regexes.end(), [&](const std::regex& regex)
+			{
+				return std::regex_match(text.begin(), text.end(), regex);
+			});
+
+	case TextMatchMode::Equal:
+	{
+		if (m_HasEmptyPattern && text.empty())
+			return true;
+		if (text.size() > m_MaxPatternLength)
+			return false;
+
+		return AnyMatch(text, [&](size_t begin, size_t end) { return begin == 0 && end == text.size(); });
+	}
+	case TextMatchMode::Contains:
+	{
+		if (m_HasEmptyPattern)
+			return true;
+
+		return AnyMatch(text, [](size_t, size_t) { return true; });
+	}
+	case TextMatchMode::StartsWith:
+	{
+		if (m_HasEmptyPattern)
+			return true;
+
+		// Nothing that starts later than this can be a prefix match
+		const auto prefix = text.substr(0, m_MaxPatternLength);
+		return AnyMatch(prefix, [](size_t begin, size_t) { return begin == 0; });
+	}
+	case TextMatchMode::EndsWith:
+	{
+		if (m_HasEmptyPattern)
+			return true;
+
+		const auto suffix = text.substr(text.size() - std::min(text.size(), m_MaxPatternLength));
+		return AnyMatch(suffix, [&](size_t, size_t end) { return end == suffix.size(); });
+	}
+	case TextMatchMode::Word:
+	{
+		return AnyMatch(text, [&](size_t begin, size_t end)
+			{
+				return (begin == 0 || !TextScanner::IsWordChar(text[begin - 1])) &&
+					(end == text.size() || !TextScanner::IsWordChar(text[end]));
+			});
+	}
+	}
+
+	throw std::runtime_error(mh::format("{}: Unknown value {}", MH_SOURCE_LOCATION_CURRENT(), mh::enum_fmt(m_Mode)));
+}
+
 bool ModerationRule::Match(const IPlayer& player) const
 {
 	return Match(player, std::string_view{});
@@ -545,18 +686,36 @@ static constexpr void RunTests()
 	static_assert(!MatchRules(TriggerMatchMode::MatchAny, unset, unset, unset));
 }
 
-bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMsg) const
+namespace
+{
+	// Stand-in for a text match whose result was already computed elsewhere
+	struct PrecomputedTextMatch
+	{
+		bool m_Result;
+		bool Match(const std::string_view&) const { return m_Result; }
+	};
+
+	template<typename T>
+	const T* get_ptr(const std::optional<T>& opt)
+	{
+		return opt ? &*opt : nullptr;
+	}
+}
+
+template<typename TTextMatch, typename TChatMsgTextMatch>
+static bool MatchTriggers(const ModerationRule::Triggers& triggers, const IPlayer& player, const std::string_view& chatMsg,
+	const TTextMatch* usernameTextMatch, const TTextMatch* personanameTextMatch, const TChatMsgTextMatch* chatMsgTextMatch)
 {
 	const auto usernameMatch = [&]()
 	{
-		if (!m_Triggers.m_UsernameTextMatch)
+		if (!usernameTextMatch)
 			return MatchResult::Unset;
 
 		const auto name = player.GetNameUnsafe();
 		if (name.empty())
 			return MatchResult::NoMatch;
 
-		if (!m_Triggers.m_UsernameTextMatch->Match(name))
+		if (!usernameTextMatch->Match(name))
 			return MatchResult::NoMatch;
 
 		return MatchResult::Match;
@@ -564,14 +723,14 @@ bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMs
 
 	const auto personanameMatch = [&]()
 	{
-		if (!m_Triggers.m_PersonanameTextMatch)
+		if (!personanameTextMatch)
 			return MatchResult::Unset;
 
 		const auto& summary = player.GetPlayerSummary();
 		if (!summary)
 			return MatchResult::NoMatch;
 
-		if (!m_Triggers.m_PersonanameTextMatch->Match(summary->m_Nickname))
+		if (!personanameTextMatch->Match(summary->m_Nickname))
 			return MatchResult::NoMatch;
 
 		return MatchResult::Match;
@@ -579,13 +738,13 @@ bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMs
 
 	const auto chatMsgMatch = [&]()
 	{
-		if (!m_Triggers.m_ChatMsgTextMatch)
+		if (!chatMsgTextMatch)
 			return MatchResult::Unset;
 
 		if (chatMsg.empty())
 			return MatchResult::NoMatch;
 
-		if (!m_Triggers.m_ChatMsgTextMatch->Match(chatMsg))
+		if (!chatMsgTextMatch->Match(chatMsg))
 			return MatchResult::NoMatch;
 
 		return MatchResult::Match;
@@ -593,14 +752,14 @@ bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMs
 
 	const auto avatarMatch = [&]()
 	{
-		if (m_Triggers.m_AvatarMatches.empty())
+		if (triggers.m_AvatarMatches.empty())
 			return MatchResult::Unset;
 
 		const auto& summary = player.GetPlayerSummary();
 		if (!summary)
 			return MatchResult::NoMatch;
 
-		for (const auto& m : m_Triggers.m_AvatarMatches)
+		for (const auto& m : triggers.m_AvatarMatches)
 		{
 			if (m.Match(summary->m_AvatarHash))
 				return MatchResult::Match;
@@ -610,26 +769,155 @@ bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMs
 	};
 
 
-	return MatchRules(m_Triggers.m_Mode, usernameMatch, chatMsgMatch, avatarMatch, personanameMatch);
+	return MatchRules(triggers.m_Mode, usernameMatch, chatMsgMatch, avatarMatch, personanameMatch);
 }
 
-bool ModerationRule::Match(const std::string_view& chatMsg) const
+template<typename TChatMsgTextMatch>
+static bool MatchChatMsgTrigger(TriggerMatchMode mode, const std::string_view& chatMsg, const TChatMsgTextMatch* chatMsgTextMatch)
 {
 	const auto chatMsgMatch = [&]()
 	{
-		if (!m_Triggers.m_ChatMsgTextMatch)
+		if (!chatMsgTextMatch)
 			return MatchResult::Unset;
 
 		if (chatMsg.empty())
 			return MatchResult::NoMatch;
 
-		if (!m_Triggers.m_ChatMsgTextMatch->Match(chatMsg))
+		if (!chatMsgTextMatch->Match(chatMsg))
 			return MatchResult::NoMatch;
 
 		return MatchResult::Match;
 	};
 
-	return MatchRules(m_Triggers.m_Mode, chatMsgMatch);
+	return MatchRules(mode, chatMsgMatch);
+}
+
+bool ModerationRule::Match(const IPlayer& player, const std::string_view& chatMsg) const
+{
+	return MatchTriggers(m_Triggers, player, chatMsg, get_ptr(m_Triggers.m_UsernameTextMatch),
+		get_ptr(m_Triggers.m_PersonanameTextMatch), get_ptr(m_Triggers.m_ChatMsgTextMatch));
+}
+
+bool ModerationRule::Match(const std::string_view& chatMsg) const
+{
+	return MatchChatMsgTrigger(m_Triggers.m_Mode, chatMsg, get_ptr(m_Triggers.m_ChatMsgTextMatch));
+}
+
+CompiledModerationRule::CompiledModerationRule(ModerationRule rule) :
+	m_Rule(std::move(rule))
+{
+	if (m_Rule.m_Triggers.m_UsernameTextMatch)
+		m_UsernameTextMatch.emplace(*m_Rule.m_Triggers.m_UsernameTextMatch);
+	if (m_Rule.m_Triggers.m_PersonanameTextMatch)
+		m_PersonanameTextMatch.emplace(*m_Rule.m_Triggers.m_PersonanameTextMatch);
+	if (m_Rule.m_Triggers.m_ChatMsgTextMatch)
+		m_ChatMsgTextMatch.emplace(*m_Rule.m_Triggers.m_ChatMsgTextMatch);
+}
+
+bool CompiledModerationRule::Match(const IPlayer& player, const std::string_view& chatMsg) const
+{
+	return MatchTriggers(m_Rule.m_Triggers, player, chatMsg, get_ptr(m_UsernameTextMatch),
+		get_ptr(m_PersonanameTextMatch), get_ptr(m_ChatMsgTextMatch));
+}
+
+bool CompiledModerationRule::Match(const std::string_view& chatMsg) const
+{
+	return MatchChatMsgTrigger(m_Rule.m_Triggers.m_Mode, chatMsg, get_ptr(m_ChatMsgTextMatch));
+}
+
+CompiledModerationRules::CompiledModerationRules(std::vector<ModerationRule> rules)
+{
+	m_Rules.reserve(rules.size());
+	m_InitialChatMatches.resize(rules.size());
+
+	for (auto& rule : rules)
+	{
+		const auto ruleIndex = uint32_t(m_Rules.size());
+		auto& compiled = m_Rules.emplace_back(std::move(rule));
+
+		const auto& chatMsgTextMatch = compiled.m_Rule.m_Triggers.m_ChatMsgTextMatch;
+		if (!chatMsgTextMatch)
+			continue;
+
+		const bool wholeWord = chatMsgTextMatch->m_Mode == TextMatchMode::Word;
+		if (!wholeWord && chatMsgTextMatch->m_Mode != TextMatchMode::Contains)
+			continue;
+
+		compiled.m_ChatMsgInAutomaton = true;
+		for (const auto& pattern : chatMsgTextMatch->m_Patterns)
+		{
+			if (wholeWord)
+			{
+				// Words are runs of \w, so anything else can never match
+				if (pattern.empty() || !std::all_of(pattern.begin(), pattern.end(), &TextScanner::IsWordChar))
+					continue;
+			}
+			else if (pattern.empty())
+			{
+				m_InitialChatMatches[ruleIndex] = true;
+				continue;
+			}
+
+			m_ChatMatcher.AddPattern(pattern);
+			m_ChatPatterns.push_back(ChatPattern
+				{
+					.m_RuleIndex = ruleIndex,
+					.m_CaseSensitive = chatMsgTextMatch->m_CaseSensitive,
+					.m_WholeWord = wholeWord,
+					.m_Pattern = pattern,
+				});
+		}
+	}
+
+	m_ChatMatcher.Build();
+}
+
+std::vector<const CompiledModerationRule*> CompiledModerationRules::FindMatches(
+	const IPlayer& player, const std::string_view& chatMsg) const
+{
+	std::vector<uint8_t> chatMatches = m_InitialChatMatches;
+	m_ChatMatcher.FindAll(chatMsg, [&](MultiPatternMatcher::PatternID id, size_t begin, size_t end)
+		{
+			const ChatPattern& pattern = m_ChatPatterns[id];
+			if (chatMatches[pattern.m_RuleIndex])
+				return;
+
+			if (pattern.m_CaseSensitive && chatMsg.substr(begin, end - begin) != pattern.m_Pattern)
+				return;
+
+			if (pattern.m_WholeWord)
+			{
+				if (begin > 0 && TextScanner::IsWordChar(chatMsg[begin - 1]))
+					return;
+				if (end < chatMsg.size() && TextScanner::IsWordChar(chatMsg[end]))
+					return;
+			}
+
+			chatMatches[pattern.m_RuleIndex] = true;
+		});
+
+	std::vector<const CompiledModerationRule*> retVal;
+	for (size_t i = 0; i < m_Rules.size(); i++)
+	{
+		const CompiledModerationRule& rule = m_Rules[i];
+
+		bool match;
+		if (rule.m_ChatMsgInAutomaton)
+		{
+			const PrecomputedTextMatch chatMsgTextMatch{ !!chatMatches[i] };
+			match = MatchTriggers(rule.m_Rule.m_Triggers, player, chatMsg, get_ptr(rule.m_UsernameTextMatch),
+				get_ptr(rule.m_PersonanameTextMatch), &chatMsgTextMatch);
+		}
+		else
+		{
+			match = rule.Match(player, chatMsg);
+		}
+
+		if (match)
+			retVal.push_back(&rule);
+	}
+
+	return retVal;
 }
 
 bool AvatarMatch::Match(const std::string_view& avatarHash) const
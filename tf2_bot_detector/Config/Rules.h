@@ -1,12 +1,15 @@
 #pragma once
 #include "ConfigHelpers.h"
+#include "Util/MultiPatternMatcher.h"
 
 #include <mh/coroutine/generator.hpp>
 #include <mh/reflection/enum.hpp>
 #include <nlohmann/json_fwd.hpp>
 
 #include <filesystem>
+#include <memory>
 #include <optional>
+#include <regex>
 #include <vector>
 
 namespace tf2_bot_detector
@@ -46,6 +49,33 @@ namespace tf2_bot_detector
 		bool Match(const std::string_view& text) const;
 	};
 
+	/// <summary>
+	/// TextMatch prepared for repeated matching. Regexes are compiled once, and every other mode
+	/// builds a case-folding automaton over all of its patterns, so Match() is a single pass over
+	/// the text no matter how many patterns there are.
+	/// </summary>
+	class CompiledTextMatch final
+	{
+	public:
+		CompiledTextMatch(const TextMatch& match);
+
+		bool Match(const std::string_view& text) const;
+
+		TextMatchMode GetMode() const { return m_Mode; }
+		bool IsCaseSensitive() const { return m_CaseSensitive; }
+
+	private:
+		template<typename TFunc> bool AnyMatch(const std::string_view& text, TFunc&& isAccepted) const;
+
+		TextMatchMode m_Mode;
+		bool m_CaseSensitive;
+		bool m_HasEmptyPattern = false;
+		size_t m_MaxPatternLength = 0;
+		std::vector<std::string> m_Patterns; // Indexed by MultiPatternMatcher::PatternID
+		MultiPatternMatcher m_Matcher;
+		std::vector<std::regex> m_Regexes;
+	};
+
 	struct AvatarMatch
 	{
 		std::string m_AvatarHash;
@@ -83,6 +113,58 @@ namespace tf2_bot_detector
 		} m_Actions;
 	};
 
+	class CompiledModerationRule final
+	{
+	public:
+		CompiledModerationRule(ModerationRule rule);
+
+		const ModerationRule& GetRule() const { return m_Rule; }
+
+		bool Match(const IPlayer& player, const std::string_view& chatMsg = {}) const;
+		bool Match(const std::string_view& chatMsg) const;
+
+	private:
+		friend class CompiledModerationRules;
+
+		ModerationRule m_Rule;
+		std::optional<CompiledTextMatch> m_UsernameTextMatch;
+		std::optional<CompiledTextMatch> m_PersonanameTextMatch;
+		std::optional<CompiledTextMatch> m_ChatMsgTextMatch;
+		bool m_ChatMsgInAutomaton = false;
+	};
+
+	/// <summary>
+	/// Immutable, precompiled snapshot of every loaded rule. Contains/Word chat message patterns
+	/// from all rule files share a single automaton, so one pass over a chat message is enough to
+	/// know which of those rules it triggers.
+	/// </summary>
+	class CompiledModerationRules final
+	{
+	public:
+		CompiledModerationRules(std::vector<ModerationRule> rules);
+
+		/// <summary>
+		/// Equivalent to calling ModerationRule::Match(player, chatMsg) on every rule.
+		/// </summary>
+		std::vector<const CompiledModerationRule*> FindMatches(const IPlayer& player, const std::string_view& chatMsg = {}) const;
+
+		size_t size() const { return m_Rules.size(); }
+
+	private:
+		std::vector<CompiledModerationRule> m_Rules;
+
+		struct ChatPattern
+		{
+			uint32_t m_RuleIndex;
+			bool m_CaseSensitive;
+			bool m_WholeWord;
+			std::string m_Pattern;
+		};
+		MultiPatternMatcher m_ChatMatcher;
+		std::vector<ChatPattern> m_ChatPatterns;      // Indexed by MultiPatternMatcher::PatternID
+		std::vector<uint8_t> m_InitialChatMatches;    // Rules with an empty Contains pattern match any message
+	};
+
 	class ModerationRules
 	{
 	public:
@@ -94,6 +176,11 @@ namespace tf2_bot_detector
 		mh::generator<const ModerationRule&> GetRules() const;
 		size_t GetRuleCount() const { return m_CFGGroup.size(); }
 
+		/// <summary>
+		/// Compiled snapshot of GetRules(). Rebuilt when the asynchronously loaded rule files finish loading.
+		/// </summary>
+		std::shared_ptr<const CompiledModerationRules> GetCompiledRules() const;
+
 	private:
 		using RuleList_t = std::vector<ModerationRule>;
 		struct RuleFile final : SharedConfigFileBase
@@ -116,6 +203,10 @@ namespace tf2_bot_detector
 			std::string GetBaseFileName() const override { return "rules"; }
 
 		} m_CFGGroup;
+
+		mutable std::shared_ptr<const CompiledModerationRules> m_CompiledRules;
+		mutable bool m_CompiledOfficialList = false;
+		mutable bool m_CompiledThirdPartyLists = false;
 	};
 }
 
@@ -429,7 +429,7 @@ catch (...)
 
 bool Settings::SaveFile() const try
 {
-	return !ConfigFileBase::SaveFile("cfg/settings.json");
+	return !ConfigFileBase::QueueSaveFile("cfg/settings.json");
 }
 catch (...)
 {
@@ -561,6 +561,7 @@ void Settings::Deserialize(const nlohmann::json& json)
 		try_get_to_defaulted(*found, m_AutoVotekickDelay, "auto_votekick_delay", DEFAULTS.m_AutoVotekickDelay);
 		try_get_to_defaulted(*found, m_AutoMark, "auto_mark", DEFAULTS.m_AutoMark);
 		try_get_to_defaulted(*found, m_LazyLoadAPIData, "lazy_load_api_data", DEFAULTS.m_LazyLoadAPIData);
+		try_get_to_defaulted(*found, m_TempDBSizeBudgetMB, "temp_db_size_budget_mb", DEFAULTS.m_TempDBSizeBudgetMB);
 		try_get_to_defaulted(*found, m_ConfigCompatibilityMode, "config_compatibility_mode", DEFAULTS.m_ConfigCompatibilityMode);
 
 		{
@@ -648,6 +649,7 @@ void Settings::Serialize(nlohmann::json& json) const
 				{ "auto_votekick_delay", m_AutoVotekickDelay },
 				{ "auto_mark", m_AutoMark },
 				{ "lazy_load_api_data", m_LazyLoadAPIData },
+				{ "temp_db_size_budget_mb", m_TempDBSizeBudgetMB },
 				{ "config_compatibility_mode", m_ConfigCompatibilityMode },
 			}
 		},
@@ -165,6 +165,12 @@ namespace tf2_bot_detector
 
 		bool m_LazyLoadAPIData = true;
 
+		/// <summary>
+		/// how big the cache of API responses can get before the least recently used ones are thrown out
+		/// </summary>
+		int m_TempDBSizeBudgetMB = 128;
+		uint64_t GetTempDBSizeBudget() const { return m_TempDBSizeBudgetMB > 0 ? uint64_t(m_TempDBSizeBudgetMB) * 1024 * 1024 : 0; }
+
 		bool m_ConfigCompatibilityMode = true;
 
 		std::optional<ReleaseChannel> m_ReleaseChannel;
@@ -16,6 +16,8 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
+#include <algorithm>
+#include <cassert>
 #include <regex>
 #include <sstream>
 #include <stdexcept>
@@ -33,55 +35,118 @@ IConsoleLine::IConsoleLine(time_point_t timestamp) :
 {
 }
 
-auto IConsoleLine::GetTypeData() -> std::list<ConsoleLineTypeData>&
+/// <summary>
+/// Prefix trie over the start of console lines (leading whitespace skipped), so each line is
+/// only handed to the parsers that could possibly accept it.
+/// </summary>
+class IConsoleLine::TypeDispatcher final
 {
-	static std::list<ConsoleLineTypeData> s_List;
-	return s_List;
-}
+public:
+	void Add(const ConsoleLineTypeData& data)
+	{
+		if (!data.m_AutoParse)
+			return;
 
-std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world)
-{
-	auto& list = GetTypeData();
+		if (data.m_Prefixes.empty())
+		{
+			m_UnprefixedParsers.push_back(data.m_TryParseFunc);
+			return;
+		}
+
+		for (const std::string_view& prefix : data.m_Prefixes)
+		{
+			assert(!prefix.empty());
+
+			uint32_t node = 0;
+			for (char c : prefix)
+				node = GetOrAddChild(node, c);
 
-	if ((s_TotalParseCount % 1024) == 0)
+			m_Nodes[node].m_Parsers.push_back(data.m_TryParseFunc);
+		}
+	}
+
+	std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args) const
 	{
-		// Periodically re-sort the line types for best performance
-		list.sort([](ConsoleLineTypeData& lhs, ConsoleLineTypeData& rhs)
+		const auto keyStart = args.m_Text.find_first_not_of(" \t\r\n\v\f"sv);
+		if (keyStart != args.m_Text.npos)
+		{
+			uint32_t node = 0;
+			for (char c : args.m_Text.substr(keyStart))
 			{
-				if (rhs.m_AutoParse != lhs.m_AutoParse)
-					return rhs.m_AutoParse < lhs.m_AutoParse;
-
-				// Intentionally reversed, we want descending order
-				return rhs.m_AutoParseSuccessCount < lhs.m_AutoParseSuccessCount;
-			});
+				node = FindChild(node, c);
+				if (node == INVALID_NODE)
+					break;
+
+				for (TryParseFunc func : m_Nodes[node].m_Parsers)
+				{
+					if (auto parsed = func(args))
+						return parsed;
+				}
+			}
+		}
+
+		for (TryParseFunc func : m_UnprefixedParsers)
+		{
+			if (auto parsed = func(args))
+				return parsed;
+		}
+
+		return nullptr;
 	}
 
-	s_TotalParseCount++;
+private:
+	static constexpr uint32_t INVALID_NODE = uint32_t(-1);
 
-	const ConsoleLineTryParseArgs args{ text, timestamp, world };
-	for (auto& data : list)
+	struct Node
 	{
-		if (!data.m_AutoParse)
-			continue;
+		std::vector<std::pair<char, uint32_t>> m_Children; // Sorted by char
+		std::vector<TryParseFunc> m_Parsers;
+	};
 
-		auto parsed = data.m_TryParseFunc(args);
-		if (!parsed)
-			continue;
+	uint32_t FindChild(uint32_t node, char c) const
+	{
+		const auto& children = m_Nodes[node].m_Children;
+		auto found = std::lower_bound(children.begin(), children.end(), c,
+			[](const std::pair<char, uint32_t>& child, char c) { return child.first < c; });
+
+		return (found != children.end() && found->first == c) ? found->second : INVALID_NODE;
+	}
+
+	uint32_t GetOrAddChild(uint32_t node, char c)
+	{
+		if (auto found = FindChild(node, c); found != INVALID_NODE)
+			return found;
+
+		const auto newNode = uint32_t(m_Nodes.size());
+		m_Nodes.emplace_back();
+
+		auto& children = m_Nodes[node].m_Children;
+		children.insert(std::lower_bound(children.begin(), children.end(), c,
+			[](const std::pair<char, uint32_t>& child, char c) { return child.first < c; }),
+			{ c, newNode });
 
-		data.m_AutoParseSuccessCount++;
-		return parsed;
+		return newNode;
 	}
 
-	//if (auto chatLine = ChatConsoleLine::TryParse(text, timestamp))
-	//	return chatLine;
+	std::vector<Node> m_Nodes{ 1 }; // [0] is the root
+	std::vector<TryParseFunc> m_UnprefixedParsers;
+};
 
-	return nullptr;
-	//return std::make_shared<GenericConsoleLine>(timestamp, std::string(text));
+auto IConsoleLine::GetTypeDispatcher() -> TypeDispatcher&
+{
+	static TypeDispatcher s_Dispatcher;
+	return s_Dispatcher;
+}
+
+std::shared_ptr<IConsoleLine> IConsoleLine::ParseConsoleLine(const std::string_view& text, time_point_t timestamp, IWorldState& world)
+{
+	const ConsoleLineTryParseArgs args{ text, timestamp, world };
+	return GetTypeDispatcher().TryParse(args);
 }
 
 void IConsoleLine::AddTypeData(ConsoleLineTypeData data)
 {
-	GetTypeData().push_back(std::move(data));
+	GetTypeDispatcher().Add(data);
 }
 
 #ifdef TF2BD_ENABLE_TESTS
@@ -31,6 +31,7 @@ namespace tf2_bot_detector
 	public:
 		using ConsoleLineBase::ConsoleLineBase;
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Client reached server_spawn." };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::ClientReachedServerSpawn; }
 		bool ShouldPrint() const override { return false; }
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -38,9 +38,11 @@ std::shared_ptr<IConsoleLine> ConfigExecLine::TryParse(const ConsoleLineTryParse
 		return std::make_shared<ConfigExecLine>(args.m_Timestamp, std::string(args.m_Text.substr(prefix.size())), true);
 
 	// Failure
-	static const std::regex s_Regex(R"regex('(.*)' not present; not executing\.)regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-		return std::make_shared<ConfigExecLine>(args.m_Timestamp, result[1].str(), false);
+	if (TextScanner scanner(args.m_Text); scanner.ConsumeLiteral("'"))
+	{
+		if (std::string_view configFileName; scanner.ConsumeUntilSuffix("' not present; not executing."sv, configFileName))
+			return std::make_shared<ConfigExecLine>(args.m_Timestamp, std::string(configFileName), false);
+	}
 
 	return nullptr;
 }
@@ -27,6 +27,7 @@ namespace tf2_bot_detector
 	public:
 		ConfigExecLine(time_point_t timestamp, std::string configFileName, bool success);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "execing ", "'" };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::ConfigExec; }
 		bool ShouldPrint() const override { return false; }
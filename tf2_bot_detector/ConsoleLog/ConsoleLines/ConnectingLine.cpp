@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,16 +32,23 @@ ConnectingLine::ConnectingLine(time_point_t timestamp, std::string address, bool
 
 std::shared_ptr<IConsoleLine> ConnectingLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
+	if (TextScanner scanner(args.m_Text); scanner.ConsumeLiteral("Connecting to"sv))
 	{
-		static const std::regex s_ConnectingRegex(R"regex(Connecting to( matchmaking server)? (.*?)(\.\.\.)?)regex", std::regex::optimize);
-		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_ConnectingRegex))
-			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[2].str(), result[1].matched, false);
+		const bool isMatchmaking = scanner.ConsumeLiteral(" matchmaking server "sv);
+		if (isMatchmaking || scanner.ConsumeLiteral(" "sv))
+		{
+			std::string_view address = scanner.ConsumeRest();
+			if (address.ends_with("..."sv))
+				address.remove_suffix(3);
+
+			return std::make_shared<ConnectingLine>(args.m_Timestamp, std::string(address), isMatchmaking, false);
+		}
 	}
 
+	if (TextScanner scanner(args.m_Text); scanner.ConsumeLiteral("Retrying "sv))
 	{
-		static const std::regex s_RetryingRegex(R"regex(Retrying (.*)\.\.\.)regex", std::regex::optimize);
-		if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_RetryingRegex))
-			return std::make_shared<ConnectingLine>(args.m_Timestamp, result[1].str(), false, true);
+		if (std::string_view address; scanner.ConsumeUntilSuffix("..."sv, address))
+			return std::make_shared<ConnectingLine>(args.m_Timestamp, std::string(address), false, true);
 	}
 
 	return nullptr;
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		ConnectingLine(time_point_t timestamp, std::string address, bool isMatchmaking, bool isRetrying);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Connecting to", "Retrying " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::Connecting; }
 		bool ShouldPrint() const override { return false; }
@@ -1,8 +1,9 @@
 #include "UI/ImGui_TF2BotDetector.h"
+#include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 
 #include <imgui_desktop/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -21,15 +22,52 @@ CvarlistConvarLine::CvarlistConvarLine(time_point_t timestamp, std::string name,
 
 std::shared_ptr<IConsoleLine> CvarlistConvarLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((\S+)\s+:\s+([-\d.]+)\s+:\s+(.+)?\s+:[\t ]+(.+)?)regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	// This parser has no prefixes, so it sees every line none of the others claimed. Bail on
+	// anything without a colon before doing any real work.
+	if (args.m_Text.find(':') == args.m_Text.npos)
+		return nullptr;
+
+	// (\S+)\s+:\s+([-\d.]+)\s+:
+	TextScanner scanner(args.m_Text);
+	std::string_view name, valueStr;
+	if (!scanner.ConsumeWhile([](char c) { return !TextScanner::IsWhitespace(c); }, name) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeLiteral(":"sv) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeWhile([](char c) { return TextScanner::IsDigit(c) || c == '-' || c == '.'; }, valueStr) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeLiteral(":"sv))
+	{
+		return nullptr;
+	}
+
+	// \s+(.+)?\s+:[\t ]+(.+)?
+	// The flags list is greedy, so it ends at the last " :" that is followed by a space or tab.
+	const std::string_view rest = scanner.GetRemaining();
+	size_t helpColon = rest.npos;
+	for (size_t i = rest.size(); i-- > 2; )
 	{
-		float value;
-		from_chars_throw(result[2], value);
-		return std::make_shared<CvarlistConvarLine>(args.m_Timestamp, result[1].str(), value, result[3].str(), result[4].str());
+		if (rest[i] == ':' && (i + 1) < rest.size() && TextScanner::IsWhitespace(rest[i - 1]) && (rest[i + 1] == ' ' || rest[i + 1] == '\t'))
+		{
+			helpColon = i;
+			break;
+		}
 	}
 
-	return nullptr;
+	if (helpColon == rest.npos || !TextScanner::IsWhitespace(rest[0]))
+		return nullptr;
+
+	TextScanner flagsScanner(rest.substr(0, helpColon - 1));
+	flagsScanner.ConsumeWhitespace(0);
+	const std::string_view flags = flagsScanner.ConsumeRest();
+
+	TextScanner helpScanner(rest.substr(helpColon + 1));
+	helpScanner.ConsumeWhile([](char c) { return c == ' ' || c == '\t'; });
+	const std::string_view helpText = helpScanner.ConsumeRest();
+
+	float value;
+	from_chars_throw(valueStr, value);
+	return std::make_shared<CvarlistConvarLine>(args.m_Timestamp, std::string(name), value, std::string(flags), std::string(helpText));
 }
 
 void CvarlistConvarLine::Print(const PrintArgs& args) const
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -34,26 +34,43 @@ DifferingLobbyReceivedLine::DifferingLobbyReceivedLine(time_point_t timestamp, c
 
 std::shared_ptr<IConsoleLine> DifferingLobbyReceivedLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(Differing lobby received\. Lobby: (.*)\/Match(\d+)\/Lobby(\d+) CurrentlyAssigned: (.*)\/Match(\d+)\/Lobby(\d+) ConnectedToMatchServer: (\d+) HasLobby: (\d+) AssignedMatchEnded: (\d+))regex",
-		std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view newLobbyID, newMatchID, newLobbyNumber;
+	std::string_view currentLobbyID, currentMatchID, currentLobbyNumber;
+	std::string_view connectedToMatchServerStr, hasLobbyStr, assignedMatchEndedStr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeLiteral("Differing lobby received. Lobby: "sv) &&
+		scanner.ConsumeUntil("/Match"sv, newLobbyID) &&
+		scanner.ConsumeDigits(newMatchID) &&
+		scanner.ConsumeLiteral("/Lobby"sv) &&
+		scanner.ConsumeDigits(newLobbyNumber) &&
+		scanner.ConsumeLiteral(" CurrentlyAssigned: "sv) &&
+		scanner.ConsumeUntil("/Match"sv, currentLobbyID) &&
+		scanner.ConsumeDigits(currentMatchID) &&
+		scanner.ConsumeLiteral("/Lobby"sv) &&
+		scanner.ConsumeDigits(currentLobbyNumber) &&
+		scanner.ConsumeLiteral(" ConnectedToMatchServer: "sv) &&
+		scanner.ConsumeDigits(connectedToMatchServerStr) &&
+		scanner.ConsumeLiteral(" HasLobby: "sv) &&
+		scanner.ConsumeDigits(hasLobbyStr) &&
+		scanner.ConsumeLiteral(" AssignedMatchEnded: "sv) &&
+		scanner.ConsumeDigits(assignedMatchEndedStr) &&
+		scanner.IsEnd())
 	{
 		Lobby newLobby;
-		newLobby.m_LobbyID = SteamID(result[1].str());
-		from_chars_throw(result[2], newLobby.m_MatchID);
-		from_chars_throw(result[3], newLobby.m_LobbyNumber);
+		newLobby.m_LobbyID = SteamID(newLobbyID);
+		from_chars_throw(newMatchID, newLobby.m_MatchID);
+		from_chars_throw(newLobbyNumber, newLobby.m_LobbyNumber);
 
 		Lobby currentLobby;
-		currentLobby.m_LobbyID = SteamID(result[4].str());
-		from_chars_throw(result[5], currentLobby.m_MatchID);
-		from_chars_throw(result[6], currentLobby.m_LobbyNumber);
+		currentLobby.m_LobbyID = SteamID(currentLobbyID);
+		from_chars_throw(currentMatchID, currentLobby.m_MatchID);
+		from_chars_throw(currentLobbyNumber, currentLobby.m_LobbyNumber);
 
 		bool connectedToMatchServer, hasLobby, assignedMatchEnded;
-		from_chars_throw(result[7], connectedToMatchServer);
-		from_chars_throw(result[8], hasLobby);
-		from_chars_throw(result[9], assignedMatchEnded);
+		from_chars_throw(connectedToMatchServerStr, connectedToMatchServer);
+		from_chars_throw(hasLobbyStr, hasLobby);
+		from_chars_throw(assignedMatchEndedStr, assignedMatchEnded);
 
 		return std::make_shared<DifferingLobbyReceivedLine>(args.m_Timestamp, newLobby, currentLobby,
 			connectedToMatchServer, hasLobby, assignedMatchEnded);
@@ -36,6 +36,7 @@ namespace tf2_bot_detector
 		DifferingLobbyReceivedLine(time_point_t timestamp, const Lobby& newLobby, const Lobby& currentLobby,
 			bool connectedToMatchServer, bool hasLobby, bool assignedMatchEnded);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Differing lobby received. Lobby: " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::DifferingLobbyReceived; }
 		bool ShouldPrint() const override { return false; }
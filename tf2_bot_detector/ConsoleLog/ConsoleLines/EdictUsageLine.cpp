@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,13 +32,19 @@ EdictUsageLine::EdictUsageLine(time_point_t timestamp, uint16_t usedEdicts, uint
 
 std::shared_ptr<IConsoleLine> EdictUsageLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(edicts  : (\d+) used of (\d+) max)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	std::string_view usedEdictsStr, totalEdictsStr;
+
+	if (scanner.ConsumeLiteral("edicts  : "sv) &&
+		scanner.ConsumeDigits(usedEdictsStr) &&
+		scanner.ConsumeLiteral(" used of "sv) &&
+		scanner.ConsumeDigits(totalEdictsStr) &&
+		scanner.ConsumeLiteral(" max"sv) &&
+		scanner.IsEnd())
 	{
 		uint16_t usedEdicts, totalEdicts;
-		from_chars_throw(result[1], usedEdicts);
-		from_chars_throw(result[2], totalEdicts);
+		from_chars_throw(usedEdictsStr, usedEdicts);
+		from_chars_throw(totalEdictsStr, totalEdicts);
 		return std::make_shared<EdictUsageLine>(args.m_Timestamp, usedEdicts, totalEdicts);
 	}
 
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		EdictUsageLine(time_point_t timestamp, uint16_t usedEdicts, uint16_t totalEdicts);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "edicts  : " };
 
 		uint16_t GetUsedEdicts() const { return m_UsedEdicts; }
 		uint16_t GetTotalEdicts() const { return m_TotalEdicts; }
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		GameQuitLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "CTFGCClientSystem::ShutdownGC" };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::GameQuit; }
 		bool ShouldPrint() const override { return false; }
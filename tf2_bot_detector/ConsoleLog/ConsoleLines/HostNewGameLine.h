@@ -29,6 +29,7 @@ namespace tf2_bot_detector
 	public:
 		HostNewGameLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "---- Host_NewGame ----" };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::HostNewGame; }
 		bool ShouldPrint() const override { return false; }
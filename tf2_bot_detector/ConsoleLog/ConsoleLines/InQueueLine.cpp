@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,40 +32,62 @@ InQueueLine::InQueueLine(time_point_t timestamp, TFMatchGroup queueType, time_po
 
 std::shared_ptr<IConsoleLine> InQueueLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(    MatchGroup: (\d+)\s+Started matchmaking:\s+(.*)\s+\(\d+ seconds ago, now is (.*)\))regex",
-		std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view matchGroupStr;
+	if (!scanner.ConsumeLiteral("    MatchGroup: "sv) ||
+		!scanner.ConsumeDigits(matchGroupStr) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeLiteral("Started matchmaking:"sv) ||
+		!scanner.ConsumeWhitespace())
+	{
+		return nullptr;
+	}
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	// <start time> (<n> seconds ago, now is <current time>)
+	std::string_view startTimeStr = scanner.GetRemaining();
 	{
-		TFMatchGroup matchGroup = TFMatchGroup::Invalid;
-		{
-			uint8_t matchGroupRaw{};
-			from_chars_throw(result[1], matchGroupRaw);
-			matchGroup = TFMatchGroup(matchGroupRaw);
-		}
+		if (!startTimeStr.ends_with(')'))
+			return nullptr;
 
-		time_point_t startTime{};
+		auto pos = startTimeStr.rfind(" seconds ago, now is "sv);
+		if (pos == startTimeStr.npos)
+			return nullptr;
+
+		const auto digitsEnd = pos;
+		while (pos > 0 && TextScanner::IsDigit(startTimeStr[pos - 1]))
+			pos--;
+
+		if (pos == digitsEnd || pos < 2 || startTimeStr[pos - 1] != '(' || !TextScanner::IsWhitespace(startTimeStr[pos - 2]))
+			return nullptr;
+
+		startTimeStr = startTimeStr.substr(0, pos - 2);
+	}
+
+	TFMatchGroup matchGroup = TFMatchGroup::Invalid;
+	{
+		uint8_t matchGroupRaw{};
+		from_chars_throw(matchGroupStr, matchGroupRaw);
+		matchGroup = TFMatchGroup(matchGroupRaw);
+	}
+
+	time_point_t startTime{};
+	{
+		std::tm startTimeFull{};
+		std::istringstream ss;
+		ss.str(std::string(startTimeStr));
+		//ss >> std::get_time(&startTimeFull, "%c");
+		ss >> std::get_time(&startTimeFull, "%a %b %d %H:%M:%S %Y");
+
+		startTimeFull.tm_isdst = -1; // auto-detect DST
+		startTime = clock_t::from_time_t(std::mktime(&startTimeFull));
+		if (startTime.time_since_epoch().count() < 0)
 		{
-			std::tm startTimeFull{};
-			std::istringstream ss;
-			ss.str(result[2].str());
-			//ss >> std::get_time(&startTimeFull, "%c");
-			ss >> std::get_time(&startTimeFull, "%a %b %d %H:%M:%S %Y");
-
-			startTimeFull.tm_isdst = -1; // auto-detect DST
-			startTime = clock_t::from_time_t(std::mktime(&startTimeFull));
-			if (startTime.time_since_epoch().count() < 0)
-			{
-				LogError(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse "s << std::quoted(result[2].str()) << " as a timestamp");
-				return nullptr;
-			}
+			LogError(MH_SOURCE_LOCATION_CURRENT(), "Failed to parse "s << std::quoted(startTimeStr) << " as a timestamp");
+			return nullptr;
 		}
-
-		return std::make_shared<InQueueLine>(args.m_Timestamp, matchGroup, startTime);
 	}
 
-	return nullptr;
+	return std::make_shared<InQueueLine>(args.m_Timestamp, matchGroup, startTime);
 }
 
 void InQueueLine::Print(const PrintArgs& args) const
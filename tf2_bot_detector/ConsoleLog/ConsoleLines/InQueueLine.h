@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		InQueueLine(time_point_t timestamp, TFMatchGroup queueType, time_point_t queueStartTime);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "MatchGroup: " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::InQueue; }
 		bool ShouldPrint() const override { return false; }
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -44,21 +44,41 @@ KillNotificationLine::KillNotificationLine(time_point_t timestamp, std::string a
 
 std::shared_ptr<IConsoleLine> KillNotificationLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((.*) killed (.*) with (.*)\.( \(crit\))?)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-	{
-		auto attacker = args.m_World.FindSteamIDForName(result[1].str());
-		auto victim = args.m_World.FindSteamIDForName(result[2].str());
-
-		return std::make_shared<KillNotificationLine>(args.m_Timestamp,
-			result[1].str(), attacker.has_value() ? attacker.value() : SteamID(),
-			result[2].str(), victim.has_value() ? victim.value() : SteamID(),
-			result[3].str(), result[4].matched
-		);
-	}
-
-	return nullptr;
+	// No fixed prefix (starts with the attacker name), so this is tried for every line
+	// <attacker> killed <victim> with <weapon>.[ (crit)]
+	constexpr auto killed = " killed "sv;
+	constexpr auto with = " with "sv;
+
+	std::string_view text = args.m_Text;
+	const bool wasCrit = text.ends_with(". (crit)"sv);
+	if (wasCrit)
+		text.remove_suffix(". (crit)"sv.size());
+	else if (text.ends_with('.'))
+		text.remove_suffix(1);
+	else
+		return nullptr;
+
+	// Names are greedy in the original pattern, so take the last possible separators
+	const auto withPos = text.rfind(with);
+	if (withPos == text.npos || withPos < killed.size())
+		return nullptr;
+
+	const auto killedPos = text.rfind(killed, withPos - killed.size());
+	if (killedPos == text.npos)
+		return nullptr;
+
+	const std::string attackerName(text.substr(0, killedPos));
+	const std::string victimName(text.substr(killedPos + killed.size(), withPos - killedPos - killed.size()));
+	const std::string weaponName(text.substr(withPos + with.size()));
+
+	auto attacker = args.m_World.FindSteamIDForName(attackerName);
+	auto victim = args.m_World.FindSteamIDForName(victimName);
+
+	return std::make_shared<KillNotificationLine>(args.m_Timestamp,
+		attackerName, attacker.has_value() ? attacker.value() : SteamID(),
+		victimName, victim.has_value() ? victim.value() : SteamID(),
+		weaponName, wasCrit
+	);
 }
 
 // i promise, i will refactor
@@ -35,6 +35,7 @@ namespace tf2_bot_detector
 	public:
 		LobbyChangedLine(time_point_t timestamp, LobbyChangeType type);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Lobby " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyChanged; }
 		LobbyChangeType GetChangeType() const { return m_ChangeType; }
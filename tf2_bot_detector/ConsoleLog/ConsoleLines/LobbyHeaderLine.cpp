@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -35,14 +35,22 @@ LobbyHeaderLine::LobbyHeaderLine(time_point_t timestamp, unsigned memberCount, u
 
 std::shared_ptr<IConsoleLine> LobbyHeaderLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(CTFLobbyShared: ID:([0-9a-f]*)\s+(\d+) member\(s\), (\d+) pending)regex", std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view lobbyID, memberCountStr, pendingCountStr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeLiteral("CTFLobbyShared: ID:"sv) &&
+		scanner.ConsumeHexDigits(lobbyID, 0) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeDigits(memberCountStr) &&
+		scanner.ConsumeLiteral(" member(s), "sv) &&
+		scanner.ConsumeDigits(pendingCountStr) &&
+		scanner.ConsumeLiteral(" pending"sv) &&
+		scanner.IsEnd())
 	{
 		unsigned memberCount, pendingCount;
-		if (!mh::from_chars(std::string_view(&*result[2].first, result[2].length()), memberCount))
+		if (!mh::from_chars(memberCountStr, memberCount))
 			throw std::runtime_error("Failed to parse lobby member count");
-		if (!mh::from_chars(std::string_view(&*result[3].first, result[3].length()), pendingCount))
+		if (!mh::from_chars(pendingCountStr, pendingCount))
 			throw std::runtime_error("Failed to parse lobby pending member count");
 
 		return std::make_shared<LobbyHeaderLine>(args.m_Timestamp, memberCount, pendingCount);
@@ -33,6 +33,7 @@ namespace tf2_bot_detector
 	public:
 		LobbyHeaderLine(time_point_t timestamp, unsigned memberCount, unsigned pendingCount);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "CTFLobbyShared: ID:" };
 
 		auto GetMemberCount() const { return m_MemberCount; }
 		auto GetPendingCount() const { return m_PendingCount; }
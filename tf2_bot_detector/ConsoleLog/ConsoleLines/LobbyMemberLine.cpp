@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -35,19 +35,34 @@ LobbyMemberLine::LobbyMemberLine(time_point_t timestamp, const LobbyMember& lobb
 
 std::shared_ptr<IConsoleLine> LobbyMemberLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(\s+(?:(?:Member)|(Pending))\[(\d+)\] (\[.*\])\s+team = (\w+)\s+type = (\w+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	if (!scanner.ConsumeWhitespace())
+		return nullptr;
+
+	const bool pending = scanner.ConsumeLiteral("Pending"sv);
+	if (!pending && !scanner.ConsumeLiteral("Member"sv))
+		return nullptr;
+
+	std::string_view indexStr, steamIDStr, teamStr, typeStr;
+	if (scanner.ConsumeLiteral("["sv) &&
+		scanner.ConsumeDigits(indexStr) &&
+		scanner.ConsumeLiteral("] "sv) &&
+		scanner.ConsumeEnclosed('[', ']', steamIDStr) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeLiteral("team = "sv) &&
+		scanner.ConsumeWord(teamStr) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeLiteral("type = "sv) &&
+		scanner.ConsumeWord(typeStr) &&
+		scanner.IsEnd())
 	{
 		LobbyMember member{};
-		member.m_Pending = result[1].matched;
-
-		if (!mh::from_chars(std::string_view(&*result[2].first, result[2].length()), member.m_Index))
-			throw std::runtime_error("Failed to parse lobby member regex");
+		member.m_Pending = pending;
 
-		member.m_SteamID = SteamID(std::string_view(&*result[3].first, result[3].length()));
+		if (!mh::from_chars(indexStr, member.m_Index))
+			throw std::runtime_error("Failed to parse lobby member index");
 
-		std::string_view teamStr(&*result[4].first, result[4].length());
+		member.m_SteamID = SteamID(steamIDStr);
 
 		if (teamStr == "TF_GC_TEAM_DEFENDERS"sv)
 			member.m_Team = LobbyMemberTeam::Defenders;
@@ -56,7 +71,6 @@ std::shared_ptr<IConsoleLine> LobbyMemberLine::TryParse(const ConsoleLineTryPars
 		else
 			throw std::runtime_error("Unknown lobby member team");
 
-		std::string_view typeStr(&*result[5].first, result[5].length());
 		if (typeStr == "MATCH_PLAYER"sv)
 			member.m_Type = LobbyMemberType::Player;
 		else if (typeStr == "INVALID_PLAYER"sv)
@@ -33,6 +33,7 @@ namespace tf2_bot_detector
 	public:
 		LobbyMemberLine(time_point_t timestamp, const LobbyMember& lobbyMember);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Member[", "Pending[" };
 
 		const LobbyMember& GetLobbyMember() const { return m_LobbyMember; }
 
@@ -30,6 +30,7 @@ namespace tf2_bot_detector
 	public:
 		using ConsoleLineBase::ConsoleLineBase;
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Failed to find lobby shared object" };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::LobbyStatusFailed; }
 		bool ShouldPrint() const override { return false; }
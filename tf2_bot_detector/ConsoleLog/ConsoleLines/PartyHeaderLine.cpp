@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,20 +32,32 @@ PartyHeaderLine::PartyHeaderLine(time_point_t timestamp, TFParty party) :
 
 std::shared_ptr<IConsoleLine> PartyHeaderLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(TFParty:\s+ID:([0-9a-f]+)\s+(\d+) member\(s\)\s+LeaderID: (\[.*\]))regex", std::regex::optimize);
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	std::string_view partyIDStr, memberCountStr, leaderIDStr;
+
+	if (scanner.ConsumeLiteral("TFParty:"sv) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeLiteral("ID:"sv) &&
+		scanner.ConsumeHexDigits(partyIDStr) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeDigits(memberCountStr) &&
+		scanner.ConsumeLiteral(" member(s)"sv) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.ConsumeLiteral("LeaderID: "sv) &&
+		scanner.ConsumeEnclosed('[', ']', leaderIDStr) &&
+		scanner.IsEnd())
 	{
 		TFParty party{};
 
 		{
 			uint64_t partyID;
-			from_chars_throw(result[1], partyID, 16);
+			from_chars_throw(partyIDStr, partyID, 16);
 			party.m_PartyID = TFPartyID(partyID);
 		}
 
-		from_chars_throw(result[2], party.m_MemberCount);
+		from_chars_throw(memberCountStr, party.m_MemberCount);
 
-		party.m_LeaderID = SteamID(result[3].str());
+		party.m_LeaderID = SteamID(leaderIDStr);
 
 		return std::make_shared<PartyHeaderLine>(args.m_Timestamp, std::move(party));
 	}
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		PartyHeaderLine(time_point_t timestamp, TFParty party);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "TFParty:" };
 
 		const TFParty& GetParty() const { return m_Party; }
 
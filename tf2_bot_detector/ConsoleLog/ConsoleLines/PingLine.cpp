@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,13 +32,19 @@ PingLine::PingLine(time_point_t timestamp, uint16_t ping, std::string playerName
 
 std::shared_ptr<IConsoleLine> PingLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex( *(\d+) ms : (.{1,32}))regex", std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view pingStr;
+	scanner.ConsumeChars(' ', 0);
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeDigits(pingStr) && scanner.ConsumeLiteral(" ms : "sv))
 	{
+		const std::string_view playerName = scanner.ConsumeRest();
+		if (playerName.empty() || playerName.size() > 32)
+			return nullptr;
+
 		uint16_t ping;
-		from_chars_throw(result[1], ping);
-		return std::make_shared<PingLine>(args.m_Timestamp, ping, result[2].str());
+		from_chars_throw(pingStr, ping);
+		return std::make_shared<PingLine>(args.m_Timestamp, ping, std::string(playerName));
 	}
 
 	return nullptr;
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		PingLine(time_point_t timestamp, uint16_t ping, std::string playerName);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9" };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::Ping; }
 		bool ShouldPrint() const override { return false; }
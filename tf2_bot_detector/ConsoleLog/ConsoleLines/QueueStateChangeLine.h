@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		QueueStateChangeLine(time_point_t timestamp, TFMatchGroup queueType, TFQueueStateChange stateChange);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "[PartyClient] " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::QueueStateChange; }
 		bool ShouldPrint() const override { return false; }
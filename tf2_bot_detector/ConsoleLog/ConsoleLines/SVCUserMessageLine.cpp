@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,16 +32,39 @@ SVCUserMessageLine::SVCUserMessageLine(time_point_t timestamp, std::string addre
 
 std::shared_ptr<IConsoleLine> SVCUserMessageLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(Msg from ((?:\d+\.\d+\.\d+\.\d+:\d+)|loopback): svc_UserMessage: type (\d+), bytes (\d+))regex", std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	if (!scanner.ConsumeLiteral("Msg from "sv))
+		return nullptr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	// loopback or ip:port
+	const TextScanner addressBegin = scanner;
+	if (!scanner.ConsumeLiteral("loopback"sv))
+	{
+		std::string_view dummy;
+		if (!scanner.ConsumeDigits(dummy) || !scanner.ConsumeLiteral("."sv) ||
+			!scanner.ConsumeDigits(dummy) || !scanner.ConsumeLiteral("."sv) ||
+			!scanner.ConsumeDigits(dummy) || !scanner.ConsumeLiteral("."sv) ||
+			!scanner.ConsumeDigits(dummy) || !scanner.ConsumeLiteral(":"sv) ||
+			!scanner.ConsumeDigits(dummy))
+		{
+			return nullptr;
+		}
+	}
+	const std::string_view address = scanner.GetConsumedSince(addressBegin);
+
+	std::string_view typeStr, bytesStr;
+	if (scanner.ConsumeLiteral(": svc_UserMessage: type "sv) &&
+		scanner.ConsumeDigits(typeStr) &&
+		scanner.ConsumeLiteral(", bytes "sv) &&
+		scanner.ConsumeDigits(bytesStr) &&
+		scanner.IsEnd())
 	{
 		uint16_t type, bytes;
-		from_chars_throw(result[2], type);
+		from_chars_throw(typeStr, type);
 
-		from_chars_throw(result[3], bytes);
+		from_chars_throw(bytesStr, bytes);
 
-		return std::make_shared<SVCUserMessageLine>(args.m_Timestamp, result[1].str(), UserMessageType(type), bytes);
+		return std::make_shared<SVCUserMessageLine>(args.m_Timestamp, std::string(address), UserMessageType(type), bytes);
 	}
 
 	return nullptr;
@@ -31,6 +31,7 @@ namespace tf2_bot_detector
 	public:
 		SVCUserMessageLine(time_point_t timestamp, std::string address, UserMessageType type, uint16_t bytes);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Msg from " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::SVC_UserMessage; }
 		bool ShouldPrint() const override;
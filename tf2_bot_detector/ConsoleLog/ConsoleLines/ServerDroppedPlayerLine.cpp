@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,11 +32,14 @@ ServerDroppedPlayerLine::ServerDroppedPlayerLine(time_point_t timestamp, std::st
 
 std::shared_ptr<IConsoleLine> ServerDroppedPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(Dropped (.*) from server \((.*)\))regex", std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view playerName, reason;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeLiteral("Dropped "sv) &&
+		scanner.ConsumeUntilLast(" from server ("sv, playerName) &&
+		scanner.ConsumeUntilSuffix(")"sv, reason))
 	{
-		return std::make_shared<ServerDroppedPlayerLine>(args.m_Timestamp, result[1].str(), result[2].str());
+		return std::make_shared<ServerDroppedPlayerLine>(args.m_Timestamp, std::string(playerName), std::string(reason));
 	}
 
 	return nullptr;
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		ServerDroppedPlayerLine(time_point_t timestamp, std::string playerName, std::string reason);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Dropped " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::ServerDroppedPlayer; }
 		bool ShouldPrint() const override { return false; }
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -34,21 +34,34 @@ ServerJoinLine::ServerJoinLine(time_point_t timestamp, std::string hostName, std
 
 std::shared_ptr<IConsoleLine> ServerJoinLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(
-		R"regex(\n(.*)\nMap: (.*)\nPlayers: (\d+) \/ (\d+)\nBuild: (\d+)\nServer Number: (\d+)\s+)regex",
-		std::regex::optimize);
+	// No fixed prefix (the first line is the server name), so this is tried for every line
+	TextScanner scanner(args.m_Text);
+	std::string_view hostName, mapName, playerCountStr, playerMaxCountStr, buildNumberStr, serverNumberStr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeLiteral("\n"sv) &&
+		scanner.ConsumeUntil("\n"sv, hostName) &&
+		scanner.ConsumeLiteral("Map: "sv) &&
+		scanner.ConsumeUntil("\n"sv, mapName) &&
+		scanner.ConsumeLiteral("Players: "sv) &&
+		scanner.ConsumeDigits(playerCountStr) &&
+		scanner.ConsumeLiteral(" / "sv) &&
+		scanner.ConsumeDigits(playerMaxCountStr) &&
+		scanner.ConsumeLiteral("\nBuild: "sv) &&
+		scanner.ConsumeDigits(buildNumberStr) &&
+		scanner.ConsumeLiteral("\nServer Number: "sv) &&
+		scanner.ConsumeDigits(serverNumberStr) &&
+		scanner.ConsumeWhitespace() &&
+		scanner.IsEnd())
 	{
 		uint32_t buildNumber, serverNumber;
-		from_chars_throw(result[5], buildNumber);
-		from_chars_throw(result[6], serverNumber);
+		from_chars_throw(buildNumberStr, buildNumber);
+		from_chars_throw(serverNumberStr, serverNumber);
 
 		uint8_t playerCount, playerMaxCount;
-		from_chars_throw(result[3], playerCount);
-		from_chars_throw(result[4], playerMaxCount);
+		from_chars_throw(playerCountStr, playerCount);
+		from_chars_throw(playerMaxCountStr, playerMaxCount);
 
-		return std::make_shared<ServerJoinLine>(args.m_Timestamp, result[1].str(), result[2].str(),
+		return std::make_shared<ServerJoinLine>(args.m_Timestamp, std::string(hostName), std::string(mapName),
 			playerCount, playerMaxCount, buildNumber, serverNumber);
 	}
 
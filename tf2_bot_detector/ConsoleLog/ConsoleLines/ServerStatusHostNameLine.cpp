@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -32,11 +32,9 @@ ServerStatusHostnameLine::ServerStatusHostnameLine(time_point_t timestamp, std::
 
 std::shared_ptr<IConsoleLine> ServerStatusHostnameLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(hostname: (.*))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (TextScanner scanner(args.m_Text); scanner.ConsumeLiteral("hostname: "sv))
 	{
-		return std::make_shared<ServerStatusHostnameLine>(args.m_Timestamp, result[1].str());
+		return std::make_shared<ServerStatusHostnameLine>(args.m_Timestamp, std::string(scanner.ConsumeRest()));
 	}
 
 	return nullptr;
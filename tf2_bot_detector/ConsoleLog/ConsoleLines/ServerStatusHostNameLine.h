@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusHostnameLine(time_point_t timestamp, std::string hostName);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "hostname: " };
 
 		const std::string& GetHostName() const { return m_HostName; }
 
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -33,16 +33,27 @@ ServerStatusMapLine::ServerStatusMapLine(time_point_t timestamp, std::string map
 
 std::shared_ptr<IConsoleLine> ServerStatusMapLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(map     : (.*) at: ((?:-|\d)+) x, ((?:-|\d)+) y, ((?:-|\d)+) z)regex", std::regex::optimize);
+	constexpr auto IsCoordinateChar = [](char c) { return c == '-' || TextScanner::IsDigit(c); };
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	std::string_view mapName, x, y, z;
+
+	if (scanner.ConsumeLiteral("map     : "sv) &&
+		scanner.ConsumeUntilLast(" at: "sv, mapName) &&
+		scanner.ConsumeWhile(IsCoordinateChar, x) &&
+		scanner.ConsumeLiteral(" x, "sv) &&
+		scanner.ConsumeWhile(IsCoordinateChar, y) &&
+		scanner.ConsumeLiteral(" y, "sv) &&
+		scanner.ConsumeWhile(IsCoordinateChar, z) &&
+		scanner.ConsumeLiteral(" z"sv) &&
+		scanner.IsEnd())
 	{
 		std::array<float, 3> pos{};
-		from_chars_throw(result[2], pos[0]);
-		from_chars_throw(result[3], pos[1]);
-		from_chars_throw(result[4], pos[2]);
+		from_chars_throw(x, pos[0]);
+		from_chars_throw(y, pos[1]);
+		from_chars_throw(z, pos[2]);
 
-		return std::make_shared<ServerStatusMapLine>(args.m_Timestamp, result[1].str(), pos);
+		return std::make_shared<ServerStatusMapLine>(args.m_Timestamp, std::string(mapName), pos);
 	}
 
 	return nullptr;
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusMapLine(time_point_t timestamp, std::string mapName, const std::array<float, 3>& position);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "map     : " };
 
 		const std::string& GetMapName() const { return m_MapName; }
 		const std::array<float, 3>& GetPosition() const { return m_Position; }
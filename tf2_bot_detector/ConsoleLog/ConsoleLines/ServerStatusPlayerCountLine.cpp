@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -33,14 +33,22 @@ ServerStatusPlayerCountLine::ServerStatusPlayerCountLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerCountLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(players : (\d+) humans, (\d+) bots \((\d+) max\))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	std::string_view playerCountStr, botCountStr, maxPlayersStr;
+
+	if (scanner.ConsumeLiteral("players : "sv) &&
+		scanner.ConsumeDigits(playerCountStr) &&
+		scanner.ConsumeLiteral(" humans, "sv) &&
+		scanner.ConsumeDigits(botCountStr) &&
+		scanner.ConsumeLiteral(" bots ("sv) &&
+		scanner.ConsumeDigits(maxPlayersStr) &&
+		scanner.ConsumeLiteral(" max)"sv) &&
+		scanner.IsEnd())
 	{
 		uint8_t playerCount, botCount, maxPlayers;
-		from_chars_throw(result[1], playerCount);
-		from_chars_throw(result[2], botCount);
-		from_chars_throw(result[3], maxPlayers);
+		from_chars_throw(playerCountStr, playerCount);
+		from_chars_throw(botCountStr, botCount);
+		from_chars_throw(maxPlayersStr, maxPlayers);
 		return std::make_shared<ServerStatusPlayerCountLine>(args.m_Timestamp, playerCount, botCount, maxPlayers);
 	}
 
@@ -29,6 +29,7 @@ namespace tf2_bot_detector
 		ServerStatusPlayerCountLine(time_point_t timestamp, uint8_t playerCount,
 			uint8_t botCount, uint8_t maxPlayers);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "players : " };
 
 		uint8_t GetPlayerCount() const { return m_PlayerCount; }
 		uint8_t GetBotCount() const { return m_BotCount; }
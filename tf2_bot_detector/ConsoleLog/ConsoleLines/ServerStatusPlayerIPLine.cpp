@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -35,10 +35,15 @@ ServerStatusPlayerIPLine::ServerStatusPlayerIPLine(time_point_t timestamp, std::
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerIPLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(udp\/ip  : (.*)  \(public ip: (.*)\))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-		return std::make_shared<ServerStatusPlayerIPLine>(args.m_Timestamp, result[1].str(), result[2].str());
+	TextScanner scanner(args.m_Text);
+	std::string_view localIP, publicIP;
+
+	if (scanner.ConsumeLiteral("udp/ip  : "sv) &&
+		scanner.ConsumeUntilLast("  (public ip: "sv, localIP) &&
+		scanner.ConsumeUntilSuffix(")"sv, publicIP))
+	{
+		return std::make_shared<ServerStatusPlayerIPLine>(args.m_Timestamp, std::string(localIP), std::string(publicIP));
+	}
 
 	return nullptr;
 }
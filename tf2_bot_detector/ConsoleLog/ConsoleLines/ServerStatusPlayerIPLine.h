@@ -31,6 +31,7 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusPlayerIPLine(time_point_t timestamp, std::string localIP, std::string publicIP);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "udp/ip  : " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::PlayerStatusIP; }
 		bool ShouldPrint() const override { return false; }
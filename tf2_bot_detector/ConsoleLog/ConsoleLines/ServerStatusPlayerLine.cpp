@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -28,6 +28,73 @@ using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
+namespace
+{
+	// Everything after the player name in
+	// #\s+(\d+)\s+"((?:.)+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(.*))?
+	struct StatusTail
+	{
+		std::string_view m_SteamID;
+		std::string_view m_ConnectedHours;
+		std::string_view m_ConnectedMins;
+		std::string_view m_ConnectedSecs;
+		std::string_view m_Ping;
+		std::string_view m_Loss;
+		std::string_view m_State;
+		std::string_view m_Address;
+	};
+
+	bool TryParseStatusTail(TextScanner scanner, StatusTail& tail)
+	{
+		tail = {};
+
+		if (!scanner.ConsumeWhitespace() ||
+			!scanner.ConsumeEnclosed('[', ']', tail.m_SteamID) ||
+			!scanner.ConsumeWhitespace())
+		{
+			return false;
+		}
+
+		// [hh:]mm:ss
+		std::string_view first, second;
+		if (!scanner.ConsumeDigits(first) || !scanner.ConsumeLiteral(":"sv) || !scanner.ConsumeDigits(second))
+			return false;
+
+		if (scanner.ConsumeLiteral(":"sv))
+		{
+			if (!scanner.ConsumeDigits(tail.m_ConnectedSecs))
+				return false;
+
+			tail.m_ConnectedHours = first;
+			tail.m_ConnectedMins = second;
+		}
+		else
+		{
+			tail.m_ConnectedMins = first;
+			tail.m_ConnectedSecs = second;
+		}
+
+		if (!scanner.ConsumeWhitespace() ||
+			!scanner.ConsumeDigits(tail.m_Ping) ||
+			!scanner.ConsumeWhitespace() ||
+			!scanner.ConsumeDigits(tail.m_Loss) ||
+			!scanner.ConsumeWhitespace() ||
+			!scanner.ConsumeWord(tail.m_State))
+		{
+			return false;
+		}
+
+		if (scanner.IsEnd())
+			return true;
+
+		if (!scanner.ConsumeWhitespace())
+			return false;
+
+		tail.m_Address = scanner.ConsumeRest();
+		return true;
+	}
+}
+
 ServerStatusPlayerLine::ServerStatusPlayerLine(time_point_t timestamp, PlayerStatus playerStatus) :
 	BaseClass(timestamp), m_PlayerStatus(std::move(playerStatus))
 {
@@ -35,55 +102,75 @@ ServerStatusPlayerLine::ServerStatusPlayerLine(time_point_t timestamp, PlayerSta
 
 std::shared_ptr<IConsoleLine> ServerStatusPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(#\s+(\d+)\s+"((?:.)+)"\s+(\[.*\])\s+(?:(\d+):)?(\d+):(\d+)\s+(\d+)\s+(\d+)\s+(\w+)(?:\s+(.*))?)regex", std::regex::optimize);
-	
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	TextScanner scanner(args.m_Text);
+	std::string_view userIDStr;
+	if (!scanner.ConsumeLiteral("#"sv) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeDigits(userIDStr) ||
+		!scanner.ConsumeWhitespace() ||
+		!scanner.ConsumeLiteral("\""sv))
 	{
-		PlayerStatus status{};
+		return nullptr;
+	}
 
-		from_chars_throw(result[1], status.m_UserID);
-		status.m_Name = result[2].str();
-		status.m_SteamID = SteamID(std::string_view(&*result[3].first, result[3].length()));
+	// Player names can contain quotes, so try every closing quote candidate starting with the last one
+	const std::string_view nameAndTail = scanner.GetRemaining();
+	std::string_view name;
+	StatusTail tail;
+	for (size_t quote = nameAndTail.rfind('"'); ; quote = nameAndTail.rfind('"', quote - 1))
+	{
+		if (quote == 0 || quote == nameAndTail.npos)
+			return nullptr;
 
-		// Connected time
+		if (TryParseStatusTail(nameAndTail.substr(quote + 1), tail))
 		{
-			uint32_t connectedHours = 0;
-			uint32_t connectedMins;
-			uint32_t connectedSecs;
+			name = nameAndTail.substr(0, quote);
+			break;
+		}
+	}
 
-			if (result[4].matched)
-				from_chars_throw(result[4], connectedHours);
+	PlayerStatus status{};
 
-			from_chars_throw(result[5], connectedMins);
-			from_chars_throw(result[6], connectedSecs);
+	from_chars_throw(userIDStr, status.m_UserID);
+	status.m_Name = name;
+	status.m_SteamID = SteamID(tail.m_SteamID);
 
-			status.m_ConnectionTime = args.m_Timestamp - ((connectedHours * 1h) + (connectedMins * 1min) + connectedSecs * 1s);
-		}
+	// Connected time
+	{
+		uint32_t connectedHours = 0;
+		uint32_t connectedMins;
+		uint32_t connectedSecs;
 
-		from_chars_throw(result[7], status.m_Ping);
-		from_chars_throw(result[8], status.m_Loss);
+		if (!tail.m_ConnectedHours.empty())
+			from_chars_throw(tail.m_ConnectedHours, connectedHours);
 
-		// State
-		{
-			const auto state = std::string_view(&*result[9].first, result[9].length());
-			if (state == "active"sv)
-				status.m_State = PlayerStatusState::Active;
-			else if (state == "spawning"sv)
-				status.m_State = PlayerStatusState::Spawning;
-			else if (state == "connecting"sv)
-				status.m_State = PlayerStatusState::Connecting;
-			else if (state == "challenging"sv)
-				status.m_State = PlayerStatusState::Challenging;
-			else
-				throw std::runtime_error("Unknown player status state "s << std::quoted(state));
-		}
+		from_chars_throw(tail.m_ConnectedMins, connectedMins);
+		from_chars_throw(tail.m_ConnectedSecs, connectedSecs);
 
-		status.m_Address = result[10].str();
+		status.m_ConnectionTime = args.m_Timestamp - ((connectedHours * 1h) + (connectedMins * 1min) + connectedSecs * 1s);
+	}
+
+	from_chars_throw(tail.m_Ping, status.m_Ping);
+	from_chars_throw(tail.m_Loss, status.m_Loss);
 
-		return std::make_shared<ServerStatusPlayerLine>(args.m_Timestamp, std::move(status));
+	// State
+	{
+		const auto state = tail.m_State;
+		if (state == "active"sv)
+			status.m_State = PlayerStatusState::Active;
+		else if (state == "spawning"sv)
+			status.m_State = PlayerStatusState::Spawning;
+		else if (state == "connecting"sv)
+			status.m_State = PlayerStatusState::Connecting;
+		else if (state == "challenging"sv)
+			status.m_State = PlayerStatusState::Challenging;
+		else
+			throw std::runtime_error("Unknown player status state "s << std::quoted(state));
 	}
 
-	return nullptr;
+	status.m_Address = tail.m_Address;
+
+	return std::make_shared<ServerStatusPlayerLine>(args.m_Timestamp, std::move(status));
 }
 
 void ServerStatusPlayerLine::Print(const PrintArgs& args) const
@@ -31,6 +31,7 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusPlayerLine(time_point_t timestamp, PlayerStatus playerStatus);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "#" };
 
 		const PlayerStatus& GetPlayerStatus() const { return m_PlayerStatus; }
 
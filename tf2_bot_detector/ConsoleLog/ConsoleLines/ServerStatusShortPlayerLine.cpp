@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -35,15 +35,19 @@ ServerStatusShortPlayerLine::ServerStatusShortPlayerLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> ServerStatusShortPlayerLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(#(\d+) - (.+))regex", std::regex::optimize);
+	TextScanner scanner(args.m_Text);
+	std::string_view clientIndexStr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	if (scanner.ConsumeLiteral("#"sv) &&
+		scanner.ConsumeDigits(clientIndexStr) &&
+		scanner.ConsumeLiteral(" - "sv) &&
+		!scanner.IsEnd())
 	{
 		PlayerStatusShort status{};
 
-		from_chars_throw(result[1], status.m_ClientIndex);
+		from_chars_throw(clientIndexStr, status.m_ClientIndex);
 		assert(status.m_ClientIndex >= 1);
-		status.m_Name = result[2].str();
+		status.m_Name = scanner.ConsumeRest();
 
 		return std::make_shared<ServerStatusShortPlayerLine>(args.m_Timestamp, std::move(status));
 	}
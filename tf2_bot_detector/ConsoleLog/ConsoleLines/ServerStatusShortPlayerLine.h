@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		ServerStatusShortPlayerLine(time_point_t timestamp, PlayerStatusShort playerStatus);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "#" };
 
 		const PlayerStatusShort& GetPlayerStatus() const { return m_PlayerStatus; }
 
@@ -5,6 +5,7 @@
 #include "UI/MainWindow.h"
 #include "UI/ImGui_TF2BotDetector.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 #include "WorldState.h"
 
@@ -15,7 +16,6 @@
 #include <mh/text/string_insertion.hpp>
 #include <Util/ScopeGuards.h>
 
-#include <regex>
 #include <sstream>
 #include <stdexcept>
 
@@ -40,16 +40,16 @@ SuicideNotificationLine::SuicideNotificationLine(time_point_t timestamp, std::st
 
 std::shared_ptr<IConsoleLine> SuicideNotificationLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex((.*) suicided.)regex", std::regex::optimize);
+	// No fixed prefix (starts with the player name), so this is tried for every line
+	// <name> suicided<any character>
+	constexpr auto suffix = " suicided"sv;
+	if (args.m_Text.size() <= suffix.size() || !args.m_Text.substr(args.m_Text.size() - suffix.size() - 1).starts_with(suffix))
+		return nullptr;
 
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
-	{
-		auto steamid = args.m_World.FindSteamIDForName(result[1].str());
+	const std::string name(args.m_Text.substr(0, args.m_Text.size() - suffix.size() - 1));
+	auto steamid = args.m_World.FindSteamIDForName(name);
 
-		return std::make_shared<SuicideNotificationLine>(args.m_Timestamp, result[1].str(), steamid.has_value() ? steamid.value() : SteamID());
-	}
-
-	return nullptr;
+	return std::make_shared<SuicideNotificationLine>(args.m_Timestamp, name, steamid.has_value() ? steamid.value() : SteamID());
 }
 
 // i promise, i will refactor (3)
@@ -28,6 +28,7 @@ namespace tf2_bot_detector
 	public:
 		TeamsSwitchedLine(time_point_t timestamp) : BaseClass(timestamp) {}
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "Teams have been switched." };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::TeamsSwitched; }
 		bool ShouldPrint() const override;
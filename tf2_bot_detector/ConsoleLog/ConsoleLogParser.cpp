@@ -2,7 +2,6 @@
 #include "Config/ChatWrappers.h"
 #include "ConsoleLog/ConsoleLineListener.h"
 #include "Log.h"
-#include "Util/RegexUtils.h"
 #include "Config/Settings.h"
 #include "WorldState.h"
 #include "Platform/Platform.h"
@@ -13,8 +12,6 @@
 #include <mh/text/formatters/error_code.hpp>
 #include <mh/future.hpp>
 
-#include <regex>
-
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace tf2_bot_detector;
@@ -103,33 +100,54 @@ void ConsoleLogParser::CustomDeleters::operator()(FILE* f) const
 
 void ConsoleLogParser::Parse(bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated)
 {
-	char buf[4096];
-	size_t readCount;
 	using clock = std::chrono::steady_clock;
 	const auto startTime = clock::now();
+	size_t parsedBytes = 0;
+
+	std::string_view readData;
 	do
 	{
-		readCount = fread(buf, sizeof(buf[0]), std::size(buf), m_File.get());
-		if (readCount > 0)
+		readData = m_FileLineBuf.Read(m_File.get());
+		if (!readData.empty())
 		{
-			m_FileLineBuf.append(buf, readCount);
 			if (m_Settings->m_SaveConsoleLogs) {
-				ILogManager::GetInstance().LogConsoleOutput(std::string_view(buf, readCount));
+				ILogManager::GetInstance().LogConsoleOutput(readData);
 			}
 
-			auto parseEnd = m_FileLineBuf.cbegin();
-			ParseChunk(parseEnd, linesProcessed, snapshotUpdated, consoleLinesUpdated);
+			const std::string_view pending = m_FileLineBuf.GetPending();
+			size_t parseEnd = 0;
+			ParseChunk(pending, parseEnd, linesProcessed, snapshotUpdated, consoleLinesUpdated);
 
-			m_FileLineBuf.erase(m_FileLineBuf.begin(), parseEnd);
+			m_FileLineBuf.Consume(parseEnd);
+			parsedBytes += parseEnd;
 		}
 
 		if (auto elapsed = clock::now() - startTime; elapsed >= 50ms)
 			break;
 
-	} while (readCount > 0);
+	} while (!readData.empty());
+
+	const auto endTime = clock::now();
+	if (m_ParseRate.m_WindowStart == clock::time_point{})
+		m_ParseRate.m_WindowStart = startTime;
+
+	m_ParseRate.m_WindowBytes += parsedBytes;
+	m_ParseRate.m_WindowParseTime += endTime - startTime;
+
+	if (const auto windowLength = endTime - m_ParseRate.m_WindowStart; windowLength >= 1s)
+	{
+		m_ParseRate.m_BytesPerSecond = float(m_ParseRate.m_WindowBytes / to_seconds(windowLength));
+		m_ParseRate.m_Throughput = m_ParseRate.m_WindowParseTime > clock::duration::zero() ?
+			float(m_ParseRate.m_WindowBytes / to_seconds(m_ParseRate.m_WindowParseTime)) : 0;
+
+		m_ParseRate.m_WindowStart = endTime;
+		m_ParseRate.m_WindowBytes = 0;
+		m_ParseRate.m_WindowParseTime = {};
+	}
 }
 
-bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed)
+bool ConsoleLogParser::ParseChatMessage(const std::string_view& buffer, const std::string_view& lineStr,
+	size_t& parseEnd, std::shared_ptr<IConsoleLine>& parsed)
 {
 	for (int i = 0; i < (int)ChatCategory::COUNT; i++)
 	{
@@ -138,8 +156,8 @@ bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter
 		auto& type = m_Settings->m_Unsaved.m_ChatMsgWrappers.value().m_Types[i];
 		if (lineStr.starts_with(type.m_Full.m_Start.m_Narrow))
 		{
-			auto searchBuf = std::string_view(m_FileLineBuf).substr(
-				&*lineStr.begin() - m_FileLineBuf.data() + type.m_Full.m_Start.m_Narrow.size());
+			auto searchBuf = buffer.substr(
+				lineStr.data() - buffer.data() + type.m_Full.m_Start.m_Narrow.size());
 
 			if (auto found = searchBuf.find(type.m_Full.m_End.m_Narrow); found != lineStr.npos)
 			{
@@ -196,7 +214,7 @@ bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter
 			else
 			{
 				LogError("Failed to locate chat message wrapper end");
-				return false; // Not enough characters in m_FileLineBuf. Try again later.
+				return false; // Not enough characters in the buffer. Try again later.
 			}
 		}
 	}
@@ -204,14 +222,12 @@ bool ConsoleLogParser::ParseChatMessage(const std::string_view& lineStr, striter
 	return true;
 }
 
-void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated)
+void ConsoleLogParser::ParseChunk(const std::string_view& buffer, size_t& parseEnd,
+	bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated)
 {
-	static const std::regex s_TimestampRegex(R"regex(\n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n])regex", std::regex::optimize);
-
-	std::smatch match;
-	while (std::regex_search(parseEnd, m_FileLineBuf.cend(), match, s_TimestampRegex))
+	while (const auto match = FindConsoleTimestamp(buffer, parseEnd))
 	{
-		auto regexBegin = parseEnd;
+		auto nextParseEnd = parseEnd;
 
 		ParseLineResult result = ParseLineResult::Unparsed;
 		bool skipTimestampParse = false;
@@ -226,11 +242,9 @@ void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool&
 
 			std::shared_ptr<IConsoleLine> parsed;
 
-			const auto prefix = match.prefix();
-			//const auto suffix = match.suffix();
-			const std::string_view lineStr(&*prefix.first, prefix.length());
+			const std::string_view lineStr = buffer.substr(parseEnd, match->m_Begin - parseEnd);
 
-			if (ParseChatMessage(lineStr, regexBegin, parsed))
+			if (ParseChatMessage(buffer, lineStr, nextParseEnd, parsed))
 			{
 				if (parsed)
 					result = ParseLineResult::Modified;
@@ -265,27 +279,14 @@ void ConsoleLogParser::ParseChunk(striter& parseEnd, bool& linesProcessed, bool&
 
 		if (result != ParseLineResult::Modified)
 		{
-			std::tm time{};
-			time.tm_isdst = -1;
-			from_chars_throw(match[1], time.tm_mon);
-			time.tm_mon -= 1;
-
-			from_chars_throw(match[2], time.tm_mday);
-			from_chars_throw(match[3], time.tm_year);
-			time.tm_year -= 1900;
-
-			from_chars_throw(match[4], time.tm_hour);
-			from_chars_throw(match[5], time.tm_min);
-			from_chars_throw(match[6], time.tm_sec);
-
-			m_CurrentTimestamp.SetRecorded(clock_t::from_time_t(std::mktime(&time)));
-			regexBegin = match[0].second;
+			m_CurrentTimestamp.SetRecorded(m_TimestampConverter.ToTimePoint(*match));
+			nextParseEnd = match->m_End;
 		}
 		else
 		{
 			m_CurrentTimestamp.InvalidateRecorded();
 		}
 
-		parseEnd = regexBegin;
+		parseEnd = nextParseEnd;
 	}
 }
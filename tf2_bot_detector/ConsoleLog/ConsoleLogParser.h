@@ -1,6 +1,8 @@
 #pragma once
 
 #include "CompensatedTS.h"
+#include "ConsoleLogTailBuffer.h"
+#include "ConsoleTimestampScanner.h"
 
 #include <filesystem>
 #include <memory>
@@ -22,6 +24,15 @@ namespace tf2_bot_detector
 
 		float GetParseProgress() const { return m_ParseProgress; }
 
+		/// <summary>
+		/// Bytes of console.log parsed per second of wall time, averaged over the last second.
+		/// </summary>
+		float GetParsedBytesPerSecond() const { return m_ParseRate.m_BytesPerSecond; }
+		/// <summary>
+		/// Bytes parsed per second actually spent parsing, i.e. how fast we could go if we had to catch up.
+		/// </summary>
+		float GetParseThroughput() const { return m_ParseRate.m_Throughput; }
+
 		const CompensatedTS& GetCurrentTimestamp() const { return m_CurrentTimestamp; }
 
 	private:
@@ -30,6 +41,7 @@ namespace tf2_bot_detector
 
 		void TrySnapshot(bool& snapshotUpdated);
 		CompensatedTS m_CurrentTimestamp;
+		ConsoleTimestampConverter m_TimestampConverter;
 
 		enum class ParseLineResult
 		{
@@ -39,10 +51,9 @@ namespace tf2_bot_detector
 			Modified,
 		};
 
-		using striter = std::string::const_iterator;
 		void Parse(bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
-		void ParseChunk(striter& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
-		bool ParseChatMessage(const std::string_view& lineStr, striter& parseEnd, std::shared_ptr<IConsoleLine>& parsed);
+		void ParseChunk(const std::string_view& buffer, size_t& parseEnd, bool& linesProcessed, bool& snapshotUpdated, bool& consoleLinesUpdated);
+		bool ParseChatMessage(const std::string_view& buffer, const std::string_view& lineStr, size_t& parseEnd, std::shared_ptr<IConsoleLine>& parsed);
 
 		struct CustomDeleters
 		{
@@ -51,7 +62,17 @@ namespace tf2_bot_detector
 		std::filesystem::path m_FileName;
 		std::unique_ptr<FILE, CustomDeleters> m_File;
 		time_point_t m_LastFileLoadAttempt{};
-		std::string m_FileLineBuf;
+		ConsoleLogTailBuffer m_FileLineBuf;
 		float m_ParseProgress = 0;
+
+		struct ParseRate
+		{
+			std::chrono::steady_clock::time_point m_WindowStart{};
+			std::chrono::steady_clock::duration m_WindowParseTime{};
+			size_t m_WindowBytes = 0;
+
+			float m_BytesPerSecond = 0;
+			float m_Throughput = 0;
+		} m_ParseRate;
 	};
 }
@@ -0,0 +1,41 @@
+#include "ConsoleLogTailBuffer.h"
+
+#include <cassert>
+#include <cstring>
+
+using namespace tf2_bot_detector;
+
+std::string_view ConsoleLogTailBuffer::Read(FILE* file)
+{
+	if ((m_Buffer.size() - m_End) < READ_BLOCK_SIZE)
+	{
+		// Only slide the tail back to the front if we get at least as many bytes back as we
+		// have to move, otherwise a long unterminated tail would get copied on every read.
+		const size_t pending = m_End - m_Begin;
+		if (m_Begin > 0 && m_Begin >= pending)
+		{
+			std::memmove(m_Buffer.data(), m_Buffer.data() + m_Begin, pending);
+			m_Begin = 0;
+			m_End = pending;
+		}
+
+		if ((m_Buffer.size() - m_End) < READ_BLOCK_SIZE)
+			m_Buffer.resize(m_End + READ_BLOCK_SIZE);
+	}
+
+	const size_t readCount = fread(m_Buffer.data() + m_End, sizeof(char), READ_BLOCK_SIZE, file);
+	if (readCount < READ_BLOCK_SIZE)
+		clearerr(file); // We're tailing a file that is still being written to, EOF is not sticky for us
+
+	m_End += readCount;
+	return std::string_view(m_Buffer.data() + m_End - readCount, readCount);
+}
+
+void ConsoleLogTailBuffer::Consume(size_t count)
+{
+	assert(count <= (m_End - m_Begin));
+	m_Begin += count;
+
+	if (m_Begin == m_End)
+		m_Begin = m_End = 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdio>
+#include <string_view>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Contiguous read-ahead buffer used to tail console.log.
+	///
+	/// New data is read in large blocks directly behind the unconsumed tail, and the consumed
+	/// prefix is only reclaimed once it is at least as large as the tail that has to be moved.
+	/// Every byte is therefore copied a bounded number of times no matter how the file is
+	/// split across reads, and pending data can always be handed out as a single string_view.
+	/// </summary>
+	class ConsoleLogTailBuffer final
+	{
+	public:
+		static constexpr size_t READ_BLOCK_SIZE = 256 * 1024;
+
+		/// <summary>
+		/// Reads up to READ_BLOCK_SIZE new bytes from the file.
+		/// </summary>
+		/// <returns>The bytes that were just read. Empty if we are caught up with the file.</returns>
+		std::string_view Read(FILE* file);
+
+		/// <summary>
+		/// Everything that has been read but not consumed yet. Invalidated by Read().
+		/// </summary>
+		std::string_view GetPending() const { return std::string_view(m_Buffer.data() + m_Begin, m_End - m_Begin); }
+		void Consume(size_t count);
+
+	private:
+		std::vector<char> m_Buffer;
+		size_t m_Begin = 0;
+		size_t m_End = 0;
+	};
+}
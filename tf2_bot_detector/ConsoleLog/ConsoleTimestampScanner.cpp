@@ -0,0 +1,105 @@
+#include "ConsoleTimestampScanner.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// '0' stands in for any decimal digit
+	constexpr std::string_view TIMESTAMP_FORMAT = "\n00/00/0000 - 00:00:00:";
+	constexpr size_t TIMESTAMP_LENGTH = TIMESTAMP_FORMAT.size() + 1; // + trailing ' ' or '\n'
+
+	inline bool IsDigit(char c)
+	{
+		return unsigned(c - '0') < 10;
+	}
+
+	inline int ParseDigits(const char* str, size_t count)
+	{
+		int retVal = 0;
+		for (size_t i = 0; i < count; i++)
+			retVal = retVal * 10 + (str[i] - '0');
+
+		return retVal;
+	}
+
+	inline bool IsTimestampAt(const char* str)
+	{
+		for (size_t i = 1; i < TIMESTAMP_FORMAT.size(); i++)
+		{
+			if (TIMESTAMP_FORMAT[i] == '0')
+			{
+				if (!IsDigit(str[i]))
+					return false;
+			}
+			else if (str[i] != TIMESTAMP_FORMAT[i])
+			{
+				return false;
+			}
+		}
+
+		const char last = str[TIMESTAMP_FORMAT.size()];
+		return last == ' ' || last == '\n';
+	}
+}
+
+std::optional<ConsoleTimestamp> tf2_bot_detector::FindConsoleTimestamp(const std::string_view& text, size_t offset)
+{
+	const char* const begin = text.data();
+	const char* const end = begin + text.size();
+
+	const char* it = begin + std::min(offset, text.size());
+	while ((end - it) >= ptrdiff_t(TIMESTAMP_LENGTH))
+	{
+		// Anything after this newline is too short to match, and so is every later newline
+		it = static_cast<const char*>(std::memchr(it, '\n', (end - it) - TIMESTAMP_LENGTH + 1));
+		if (!it)
+			break;
+
+		if (IsTimestampAt(it))
+		{
+			ConsoleTimestamp retVal;
+			retVal.m_Begin = size_t(it - begin);
+			retVal.m_End = retVal.m_Begin + TIMESTAMP_LENGTH;
+			retVal.m_Month = ParseDigits(it + 1, 2);
+			retVal.m_Day = ParseDigits(it + 4, 2);
+			retVal.m_Year = ParseDigits(it + 7, 4);
+			retVal.m_Hour = ParseDigits(it + 14, 2);
+			retVal.m_Minute = ParseDigits(it + 17, 2);
+			retVal.m_Second = ParseDigits(it + 20, 2);
+			return retVal;
+		}
+
+		it++;
+	}
+
+	return std::nullopt;
+}
+
+time_point_t ConsoleTimestampConverter::ToTimePoint(const ConsoleTimestamp& timestamp)
+{
+	const uint64_t minuteKey = (uint64_t(1) << 63) |
+		(uint64_t(timestamp.m_Year) << 32) |
+		(uint64_t(timestamp.m_Month) << 24) |
+		(uint64_t(timestamp.m_Day) << 16) |
+		(uint64_t(timestamp.m_Hour) << 8) |
+		uint64_t(timestamp.m_Minute);
+
+	if (minuteKey != m_CachedMinuteKey)
+	{
+		std::tm time{};
+		time.tm_isdst = -1;
+		time.tm_mon = timestamp.m_Month - 1;
+		time.tm_mday = timestamp.m_Day;
+		time.tm_year = timestamp.m_Year - 1900;
+		time.tm_hour = timestamp.m_Hour;
+		time.tm_min = timestamp.m_Minute;
+
+		m_CachedMinuteTime = std::mktime(&time);
+		m_CachedMinuteKey = minuteKey;
+	}
+
+	return clock_t::from_time_t(m_CachedMinuteTime) + std::chrono::seconds(timestamp.m_Second);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+#include <ctime>
+#include <optional>
+#include <string_view>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// A "\nMM/DD/YYYY - HH:MM:SS: " line prefix found in the console log.
+	/// </summary>
+	struct ConsoleTimestamp
+	{
+		size_t m_Begin = 0; // Offset of the '\n' preceding the timestamp
+		size_t m_End = 0;   // Offset one past the timestamp, including its trailing ' ' or '\n'
+
+		int m_Year = 0;
+		int m_Month = 0;    // 1-12
+		int m_Day = 0;
+		int m_Hour = 0;
+		int m_Minute = 0;
+		int m_Second = 0;
+	};
+
+	/// <summary>
+	/// Fixed-format replacement for the old \n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n]
+	/// regex search. Jumps between newlines with memchr and only checks the fixed width prefix after each.
+	/// </summary>
+	std::optional<ConsoleTimestamp> FindConsoleTimestamp(const std::string_view& text, size_t offset = 0);
+
+	/// <summary>
+	/// Converts console timestamps (local time) to time points. Console lines come in bursts that all share
+	/// the same minute, so the std::mktime result is cached per minute and the seconds are added on top.
+	/// </summary>
+	class ConsoleTimestampConverter final
+	{
+	public:
+		time_point_t ToTimePoint(const ConsoleTimestamp& timestamp);
+
+	private:
+		uint64_t m_CachedMinuteKey = 0;
+		std::time_t m_CachedMinuteTime{};
+	};
+}
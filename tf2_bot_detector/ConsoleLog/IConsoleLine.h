@@ -2,8 +2,8 @@
 
 #include "Clock.h"
 
-#include <list>
 #include <memory>
+#include <span>
 #include <string_view>
 
 namespace tf2_bot_detector
@@ -105,21 +105,27 @@ namespace tf2_bot_detector
 			TryParseFunc m_TryParseFunc = nullptr;
 			const std::type_info* m_TypeInfo = nullptr;
 
-			size_t m_AutoParseSuccessCount = 0;
+			// Literal prefixes that every line accepted by m_TryParseFunc starts with, once leading
+			// whitespace is skipped. If empty, m_TryParseFunc is tried for every line, so it has to
+			// reject unrelated lines cheaply.
+			std::span<const std::string_view> m_Prefixes;
 			bool m_AutoParse = true;
 		};
 
-		//static const ConsoleLineTypeData* GetTypeData() { return s_TypeData; }
 		static void AddTypeData(ConsoleLineTypeData data);
 
 	private:
 		time_point_t m_Timestamp;
 
-		static std::list<ConsoleLineTypeData>& GetTypeData();
-		inline static ConsoleLineTypeData* s_TypeData = nullptr;
-		inline static size_t s_TotalParseCount = 0;
+		class TypeDispatcher;
+		static TypeDispatcher& GetTypeDispatcher();
 	};
 
+	/// <summary>
+	/// Line types may declare
+	///   static constexpr std::string_view PARSE_PREFIXES[] = { ... };
+	/// to only have TryParse called for lines starting with one of those prefixes.
+	/// </summary>
 	template<typename TSelf, bool AutoParse = true>
 	class ConsoleLineBase : public IConsoleLine
 	{
@@ -127,6 +133,14 @@ namespace tf2_bot_detector
 		ConsoleLineBase(time_point_t timestamp) : IConsoleLine(timestamp) {}
 
 	private:
+		static constexpr std::span<const std::string_view> GetParsePrefixes()
+		{
+			if constexpr (requires { TSelf::PARSE_PREFIXES; })
+				return TSelf::PARSE_PREFIXES;
+			else
+				return {};
+		}
+
 		#ifdef __linux__
 		__attribute__((__used__))
 		#endif
@@ -138,6 +152,7 @@ namespace tf2_bot_detector
 					{
 						.m_TryParseFunc = &TSelf::TryParse,
 						.m_TypeInfo = &typeid(TSelf),
+						.m_Prefixes = GetParsePrefixes(),
 						.m_AutoParse = AutoParse
 					});
 			}
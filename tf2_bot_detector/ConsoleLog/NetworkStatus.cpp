@@ -1,6 +1,8 @@
 #include "NetworkStatus.h"
 #include "UI/ImGui_TF2BotDetector.h"
+#include "Util/RegexCache.h"
 #include "Util/RegexUtils.h"
+#include "Util/TextScanner.h"
 #include "Log.h"
 
 #include <mh/text/format.hpp>
@@ -9,9 +11,6 @@ using namespace tf2_bot_detector;
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
-// net_status
-static std::regex s_DataPerClientOut(R"regex(           per client out (\d+\.\d), in (\d+\.\d) kB\/s)regex", std::regex::optimize);
-
 SplitPacketLine::SplitPacketLine(time_point_t timestamp, SplitPacket packet) :
 	BaseClass(timestamp), m_Packet(std::move(packet))
 {
@@ -19,14 +18,40 @@ SplitPacketLine::SplitPacketLine(time_point_t timestamp, SplitPacket packet) :
 
 std::shared_ptr<IConsoleLine> SplitPacketLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static std::regex s_Regex(R"regex(<-- \[(.{3})\] Split packet +(\d+)\/ +(\d+) seq +(\d+) size +(\d+) mtu +(\d+) from ([0-9.:a-fA-F]+:\d+))regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	constexpr auto IsAddressChar = [](char c)
+	{
+		return TextScanner::IsHexDigit(c) || (c >= 'A' && c <= 'F') || c == '.' || c == ':';
+	};
+
+	TextScanner scanner(args.m_Text);
+	std::string_view socket, index, count, sequence, size, mtu, address;
+
+	if (scanner.ConsumeLiteral("<-- ["sv) &&
+		scanner.ConsumeCount(3, socket) &&
+		scanner.ConsumeLiteral("] Split packet"sv) &&
+		scanner.ConsumeChars(' ') && scanner.ConsumeDigits(index) &&
+		scanner.ConsumeLiteral("/"sv) &&
+		scanner.ConsumeChars(' ') && scanner.ConsumeDigits(count) &&
+		scanner.ConsumeLiteral(" seq"sv) &&
+		scanner.ConsumeChars(' ') && scanner.ConsumeDigits(sequence) &&
+		scanner.ConsumeLiteral(" size"sv) &&
+		scanner.ConsumeChars(' ') && scanner.ConsumeDigits(size) &&
+		scanner.ConsumeLiteral(" mtu"sv) &&
+		scanner.ConsumeChars(' ') && scanner.ConsumeDigits(mtu) &&
+		scanner.ConsumeLiteral(" from "sv) &&
+		scanner.ConsumeWhile(IsAddressChar, address) &&
+		scanner.IsEnd())
 	{
+		// [0-9.:a-fA-F]+:\d+
+		if (const auto portSeparator = address.rfind(':');
+			portSeparator == address.npos || portSeparator == 0 || !TextScanner::IsDigits(address.substr(portSeparator + 1)))
+		{
+			return nullptr;
+		}
+
 		SplitPacket packet;
 
 		{
-			auto socket = to_string_view(result[1]);
 			if (socket == "cl "sv)
 				packet.m_SocketType = SocketType::Client;
 			else if (socket == "sv "sv)
@@ -43,16 +68,16 @@ std::shared_ptr<IConsoleLine> SplitPacketLine::TryParse(const ConsoleLineTryPars
 				throw std::runtime_error(mh::format("Unknown socket type {}", std::quoted(socket)));
 		}
 
-		from_chars_throw(result[2], packet.m_Index);
+		from_chars_throw(index, packet.m_Index);
 		assert(packet.m_Index > 0);
 		if (packet.m_Index > 0)
 			packet.m_Index--;
 
-		from_chars_throw(result[3], packet.m_Count);
-		from_chars_throw(result[4], packet.m_Sequence);
-		from_chars_throw(result[5], packet.m_Size);
-		from_chars_throw(result[6], packet.m_MTU);
-		packet.m_Address = result[7].str();
+		from_chars_throw(count, packet.m_Count);
+		from_chars_throw(sequence, packet.m_Sequence);
+		from_chars_throw(size, packet.m_Size);
+		from_chars_throw(mtu, packet.m_MTU);
+		packet.m_Address = address;
 
 		return std::make_shared<SplitPacketLine>(args.m_Timestamp, std::move(packet));
 	}
@@ -95,41 +120,51 @@ NetStatusConfigLine::NetStatusConfigLine(time_point_t timestamp,
 
 std::shared_ptr<IConsoleLine> NetStatusConfigLine::TryParse(const ConsoleLineTryParseArgs& args)
 {
-	static const std::regex s_Regex(R"regex(- Config: (.*), (.*), (\d+) connections)regex", std::regex::optimize);
-
-	if (svmatch result; std::regex_match(args.m_Text.begin(), args.m_Text.end(), result, s_Regex))
+	// - Config: <player mode>, <server mode>, <n> connections
+	TextScanner scanner(args.m_Text);
+	std::string_view config;
+	if (!scanner.ConsumeLiteral("- Config: "sv) || !scanner.ConsumeUntilSuffix(" connections"sv, config))
+		return nullptr;
+
+	// Both of the (.*) groups are greedy, so split on the last separators
+	const auto countSeparator = config.rfind(", "sv);
+	if (countSeparator == config.npos)
+		return nullptr;
+
+	const std::string_view connectionCountStr = config.substr(countSeparator + 2);
+	const std::string_view modes = config.substr(0, countSeparator);
+	const auto modeSeparator = modes.rfind(", "sv);
+	if (!TextScanner::IsDigits(connectionCountStr) || modeSeparator == modes.npos)
+		return nullptr;
+
+	const std::string_view playerModeStr = modes.substr(0, modeSeparator);
+	PlayerMode playerMode;
+	if (playerModeStr == "Multiplayer"sv)
+		playerMode = PlayerMode::Multiplayer;
+	else if (playerModeStr == "Singleplayer"sv)
+		playerMode = PlayerMode::Singleplayer;
+	else
 	{
-		const std::string_view playerModeStr(&*result[1].first, result[1].length());
-		PlayerMode playerMode;
-		if (playerModeStr == "Multiplayer"sv)
-			playerMode = PlayerMode::Multiplayer;
-		else if (playerModeStr == "Singleplayer"sv)
-			playerMode = PlayerMode::Singleplayer;
-		else
-		{
-			LogError(MH_SOURCE_LOCATION_CURRENT(), "Unknown player mode {}", std::quoted(playerModeStr));
-			return nullptr;
-		}
-
-		const std::string_view serverModeStr(&*result[2].first, result[2].length());
-		ServerMode serverMode;
-		if (serverModeStr == "dedicated"sv)
-			serverMode = ServerMode::Dedicated;
-		else if (serverModeStr == "listen"sv)
-			serverMode = ServerMode::Listen;
-		else
-		{
-			LogError(MH_SOURCE_LOCATION_CURRENT(), "Unknown server mode {}", std::quoted(serverModeStr));
-			return nullptr;
-		}
-
-		unsigned connectionCount;
-		from_chars_throw(result[3], connectionCount);
+		LogError(MH_SOURCE_LOCATION_CURRENT(), "Unknown player mode {}", std::quoted(playerModeStr));
+		return nullptr;
+	}
 
-		return std::make_shared<NetStatusConfigLine>(args.m_Timestamp, playerMode, serverMode, connectionCount);
+	const std::string_view serverModeStr = modes.substr(modeSeparator + 2);
+	ServerMode serverMode;
+	if (serverModeStr == "dedicated"sv)
+		serverMode = ServerMode::Dedicated;
+	else if (serverModeStr == "listen"sv)
+		serverMode = ServerMode::Listen;
+	else
+	{
+		LogError(MH_SOURCE_LOCATION_CURRENT(), "Unknown server mode {}", std::quoted(serverModeStr));
+		return nullptr;
 	}
 
-	return nullptr;
+	unsigned connectionCount;
+	from_chars_throw(connectionCountStr, connectionCount);
+
+	return std::make_shared<NetStatusConfigLine>(args.m_Timestamp, playerMode, serverMode, connectionCount);
 }
 
 void NetStatusConfigLine::Print(const PrintArgs& args) const
@@ -143,9 +178,9 @@ void NetStatusConfigLine::Print(const PrintArgs& args) const
 bool NetChannelDualFloatLineBase::TryParse(const std::string_view& text,
 	const std::string_view& pattern, float& f0, float& f1)
 {
-	const std::regex s_Regex(pattern.data(), pattern.data() + pattern.size());
+	const std::regex& regex = RegexCache::Get().GetRegex(pattern);
 
-	if (svmatch result; std::regex_match(text.begin(), text.end(), result, s_Regex))
+	if (svmatch result; std::regex_match(text.begin(), text.end(), result, regex))
 	{
 		from_chars_throw(result[1], f0);
 		from_chars_throw(result[2], f1);
@@ -47,6 +47,7 @@ namespace tf2_bot_detector
 		SplitPacketLine(time_point_t timestamp, SplitPacket packet);
 
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "<-- [" };
 
 		const SplitPacket& GetSplitPacket() const { return m_Packet; }
 
@@ -77,6 +78,7 @@ namespace tf2_bot_detector
 
 		NetStatusConfigLine(time_point_t timestamp, PlayerMode playerMode, ServerMode serverMode, unsigned connectionCount);
 		static std::shared_ptr<IConsoleLine> TryParse(const ConsoleLineTryParseArgs& args);
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- Config: " };
 
 		ConsoleLineType GetType() const override { return ConsoleLineType::NetStatusConfig; }
 		bool ShouldPrint() const override { return false; }
@@ -153,6 +155,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- latency: {.1f}, loss {.2f}";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- latency: (\d+\.\d+), loss (\d+\.\d+))regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- latency: " };
 	};
 
 	class NetChannelPacketsLine final : public NetChannelDualFloatLine<NetChannelPacketsLine>
@@ -172,6 +175,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- packets: in {.1f}/s, out {.1f}/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- packets: in (\d+\.\d+)\/s, out (\d+\.\d+)\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- packets: in " };
 	};
 
 	class NetChannelChokeLine final : public NetChannelDualFloatLine<NetChannelChokeLine>
@@ -189,6 +193,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- choke: in {.2f}, out {.2f}";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- choke: in (\d+\.\d+), out (\d+\.\d+))regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- choke: in " };
 	};
 
 	class NetChannelFlowLine final : public NetChannelDualFloatLine<NetChannelFlowLine>
@@ -208,6 +213,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- flow: in {.1f}, out {.1f} KB/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- flow: in (\d+\.\d+), out (\d+\.\d+) kB\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- flow: in " };
 	};
 
 	class NetChannelTotalLine final : public NetChannelDualFloatLine<NetChannelTotalLine>
@@ -227,6 +233,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- total: in {.1f}, out {.1f} MB";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- total: in (\d+\.\d+), out (\d+\.\d+) MB)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- total: in " };
 	};
 
 	class NetLatencyLine final : public NetChannelDualFloatLine<NetLatencyLine>
@@ -246,6 +253,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Latency: avg out {.2f}s, in {.2f}s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- Latency: avg out (\d+\.\d+)s, in (\d+\.\d+)s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- Latency: avg out " };
 	};
 
 	class NetLossLine final : public NetChannelDualFloatLine<NetLossLine>
@@ -265,6 +273,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Loss:    avg out {.1f}, in {.1f}";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- Loss:    avg out (\d+\.\d+), in (\d+\.\d+))regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- Loss:    avg out " };
 	};
 
 	class NetPacketsTotalLine final : public NetChannelDualFloatLine<NetPacketsTotalLine>
@@ -284,6 +293,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Packets: net total out  {.1f}/s, in {.1f}/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- Packets: net total out  (\d+\.\d)\/s, in (\d+\.\d)\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- Packets: net total out  " };
 	};
 
 	class NetPacketsPerClientLine final : public NetChannelDualFloatLine<NetPacketsPerClientLine>
@@ -303,6 +313,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "           per client out {.1f}/s, in {.1f}/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(           per client out (\d+\.\d)\/s, in (\d+\.\d)\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "per client out " };
 	};
 
 	class NetDataTotalLine final : public NetChannelDualFloatLine<NetDataTotalLine>
@@ -322,6 +333,7 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "- Data:    net total out  {.1f}, in {.1f} kB/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(- Data:    net total out  (\d+\.\d), in (\d+\.\d) kB\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "- Data:    net total out  " };
 	};
 
 	class NetDataPerClientLine final : public NetChannelDualFloatLine<NetDataPerClientLine>
@@ -341,5 +353,6 @@ namespace tf2_bot_detector
 
 		static constexpr std::string_view PRINT_FORMAT_STRING =  "           per client out {.1f}, in {.1f} kB/s";
 		static constexpr std::string_view REGEX_PATTERN = R"regex(           per client out (\d+\.\d), in (\d+\.\d) kB\/s)regex";
+		static constexpr std::string_view PARSE_PREFIXES[] = { "per client out " };
 	};
 }
@@ -86,8 +86,8 @@ void tf2_bot_detector::DB::CreateTable(SQLite::Database& db, const TableDefiniti
 	return CreateTable(db, table.GetTableName(), cols.data(), cols.data() + cols.size(), flags);
 }
 
-void tf2_bot_detector::DB::InsertInto(SQLite::Database& db, const std::string_view& tableName, std::initializer_list<ColumnData> columns,
-	InsertIntoConstraintResolver resolver) try
+std::string tf2_bot_detector::DB::CreateInsertIntoQuery(const std::string_view& tableName,
+	std::span<const ColumnDefinition* const> columns, InsertIntoConstraintResolver resolver)
 {
 	std::string query = "INSERT OR ";
 
@@ -112,51 +112,98 @@ void tf2_bot_detector::DB::InsertInto(SQLite::Database& db, const std::string_vi
 
 	query.append(" INTO \"").append(tableName).append("\" (");
 
-	for (const ColumnData& column : columns)
+	for (size_t i = 0; i < columns.size(); i++)
 	{
-		if (&column != columns.begin())
+		if (i > 0)
 			query.append(", ");
 
-		query.append("\"").append(column.m_Column.get().m_Name).append("\"");
+		query.append("\"").append(columns[i]->m_Name).append("\"");
 	}
 
 	query.append(") VALUES (");
 
+	for (size_t i = 0; i < columns.size(); i++)
 	{
-		int i = 0;
-		for (const ColumnData& column : columns)
-		{
-			if (&column != columns.begin())
-				query.append(", ");
+		if (i > 0)
+			query.append(", ");
 
-			mh::format_to(std::back_inserter(query), "?{}", ++i);
-		}
+		mh::format_to(std::back_inserter(query), "?{}", i + 1);
 	}
 
 	query.append(")");
+	return query;
+}
 
-	SQLite::Statement statement(db, query);
+std::string tf2_bot_detector::DB::CreateSelectQuery(const std::string_view& tableName,
+	std::span<const ColumnDefinition* const> columns, const ColumnDefinition& whereEquals)
+{
+	std::string query = "SELECT ";
 
+	for (size_t i = 0; i < columns.size(); i++)
+	{
+		if (i > 0)
+			query.append(", ");
+
+		query.append("\"").append(columns[i]->m_Name).append("\"");
+	}
+
+	query.append(" FROM \"").append(tableName).append("\" WHERE \"").append(whereEquals.m_Name).append("\" == ?1");
+	return query;
+}
+
+void tf2_bot_detector::DB::BindColumnData(SQLite::Statement& statement, int index, const ColumnData& data)
+{
+	std::visit([&](const auto& val)
+		{
+			using type = std::decay_t<decltype(val)>;
+			if constexpr (std::is_same_v<type, BlobData>)
+				statement.bind(index, val.m_Data, static_cast<int>(val.m_Size));
+			else if constexpr (std::is_same_v<type, std::monostate>)
+				statement.bind(index);
+			else
+				statement.bind(index, val);
+
+		}, data.m_Data);
+}
+
+namespace
+{
+	std::vector<const ColumnDefinition*> GetColumnDefinitions(std::initializer_list<ColumnData> columns)
+	{
+		std::vector<const ColumnDefinition*> definitions;
+		definitions.reserve(columns.size());
+		for (const ColumnData& column : columns)
+			definitions.push_back(&column.m_Column.get());
+
+		return definitions;
+	}
+
+	void BindColumns(SQLite::Statement& statement, std::initializer_list<ColumnData> columns)
 	{
 		int i = 1;
 		for (const ColumnData& column : columns)
-		{
-			std::visit([&](const auto& val)
-				{
-					using type = std::decay_t<decltype(val)>;
-					if constexpr (std::is_same_v<type, BlobData>)
-						statement.bind(i, val.m_Data, static_cast<int>(val.m_Size));
-					else if constexpr (std::is_same_v<type, std::monostate>)
-						statement.bind(i);
-					else
-						statement.bind(i, val);
-
-				}, column.m_Data);
-
-			i++;
-		}
+			BindColumnData(statement, i++, column);
 	}
+}
 
+void tf2_bot_detector::DB::InsertInto(SQLite::Database& db, const std::string_view& tableName, std::initializer_list<ColumnData> columns,
+	InsertIntoConstraintResolver resolver) try
+{
+	SQLite::Statement statement(db, CreateInsertIntoQuery(tableName, GetColumnDefinitions(columns), resolver));
+	BindColumns(statement, columns);
+	statement.exec();
+}
+catch (...)
+{
+	LogException();
+	throw;
+}
+
+void tf2_bot_detector::DB::InsertInto(StatementCache& statements, const std::string_view& tableName, std::initializer_list<ColumnData> columns,
+	InsertIntoConstraintResolver resolver) try
+{
+	SQLite::Statement& statement = statements.Get(CreateInsertIntoQuery(tableName, GetColumnDefinitions(columns), resolver));
+	BindColumns(statement, columns);
 	statement.exec();
 }
 catch (...)
@@ -170,6 +217,32 @@ void tf2_bot_detector::DB::ReplaceInto(SQLite::Database& db, const std::string_v
 	return InsertInto(db, tableName, columns, InsertIntoConstraintResolver::Replace);
 }
 
+void tf2_bot_detector::DB::ReplaceInto(StatementCache& statements, const std::string_view& tableName, std::initializer_list<ColumnData> columns)
+{
+	return InsertInto(statements, tableName, columns, InsertIntoConstraintResolver::Replace);
+}
+
+StatementCache::StatementCache(SQLite::Database& db) :
+	m_DB(db)
+{
+}
+
+SQLite::Statement& StatementCache::Get(const std::string& query)
+{
+	auto it = m_Statements.find(query);
+	if (it == m_Statements.end())
+	{
+		it = m_Statements.try_emplace(query, m_DB, query).first;
+	}
+	else
+	{
+		it->second.reset();
+		it->second.clearBindings();
+	}
+
+	return it->second;
+}
+
 ColumnData::ColumnData(const ColumnDefinition& column, uint32_t intData) :
 	ColumnData(column, int64_t(intData))
 {
@@ -204,6 +277,12 @@ ColumnData::ColumnData(const ColumnDefinition& column, const BlobData& blobData)
 	assert(column.m_Type == ColumnType::Blob);
 }
 
+ColumnData::ColumnData(const ColumnDefinition& column, std::nullptr_t) :
+	m_Column(column), m_Data(std::monostate{})
+{
+	assert(!(column.m_Flags & ColumnFlags::NotNull));
+}
+
 BinaryOperation::BinaryOperation(BinaryOperator operation,
 	std::unique_ptr<IOperationExpression> lhs, std::unique_ptr<IOperationExpression> rhs) :
 	m_LHS(std::move(lhs)), m_RHS(std::move(rhs)), m_Operation(operation)
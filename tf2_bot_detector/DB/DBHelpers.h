@@ -5,15 +5,22 @@
 #endif
 
 #include <SQLiteCpp/SQLiteCpp.h>
+#include <mh/raii/scope_exit.hpp>
 #include <mh/types/enum_class_bit_ops.hpp>
 
+#include <cassert>
 #include <concepts>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <span>
+#include <string>
 #include <string_view>
 #include <optional>
+#include <type_traits>
+#include <unordered_map>
 #include <variant>
+#include <vector>
 
 namespace SQLite
 {
@@ -311,7 +318,211 @@ namespace tf2_bot_detector::DB
 		Rollback,
 	};
 
+	/// <summary>
+	/// Keeps statements compiled, keyed by their SQL, so running the same query again only
+	/// rebinds its parameters. Like the connection it wraps, only use it from one thread at a time.
+	/// </summary>
+	class StatementCache
+	{
+	public:
+		explicit StatementCache(SQLite::Database& db);
+
+		SQLite::Database& GetDatabase() const { return m_DB; }
+
+		/// <summary>
+		/// Returns the compiled statement for the query, reset and with its bindings cleared.
+		/// </summary>
+		SQLite::Statement& Get(const std::string& query);
+
+	private:
+		SQLite::Database& m_DB;
+		std::unordered_map<std::string, SQLite::Statement> m_Statements;
+	};
+
+	void BindColumnData(SQLite::Statement& statement, int index, const ColumnData& data);
+
+	std::string CreateInsertIntoQuery(const std::string_view& tableName, std::span<const ColumnDefinition* const> columns,
+		InsertIntoConstraintResolver resolver = InsertIntoConstraintResolver::Abort);
+	std::string CreateSelectQuery(const std::string_view& tableName, std::span<const ColumnDefinition* const> columns,
+		const ColumnDefinition& whereEquals);
+
 	void InsertInto(SQLite::Database& db, const std::string_view& tableName, std::initializer_list<ColumnData> columns,
 		InsertIntoConstraintResolver resolver = InsertIntoConstraintResolver::Abort);
+	void InsertInto(StatementCache& statements, const std::string_view& tableName, std::initializer_list<ColumnData> columns,
+		InsertIntoConstraintResolver resolver = InsertIntoConstraintResolver::Abort);
 	void ReplaceInto(SQLite::Database& db, const std::string_view& tableName, std::initializer_list<ColumnData> columns);
+	void ReplaceInto(StatementCache& statements, const std::string_view& tableName, std::initializer_list<ColumnData> columns);
+
+	namespace detail
+	{
+		template<typename T> struct IsOptional : std::false_type {};
+		template<typename T> struct IsOptional<std::optional<T>> : std::true_type {};
+	}
+
+	/// <summary>
+	/// Binds a value the same way a ColumnData would, plus strings, bools, enums, and optionals
+	/// (bound as null if empty).
+	/// </summary>
+	template<typename T>
+	void BindColumnValue(SQLite::Statement& statement, int index, const ColumnDefinition& column, const T& value)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			BindColumnData(statement, index, ColumnData(column, value.c_str()));
+		}
+		else if constexpr (std::is_same_v<T, bool> || std::is_enum_v<T>)
+		{
+			BindColumnData(statement, index, ColumnData(column, static_cast<int64_t>(value)));
+		}
+		else if constexpr (detail::IsOptional<T>::value)
+		{
+			if (value)
+				BindColumnValue(statement, index, column, *value);
+			else
+				BindColumnData(statement, index, ColumnData(column, nullptr));
+		}
+		else
+		{
+			BindColumnData(statement, index, ColumnData(column, value));
+		}
+	}
+
+	/// <summary>
+	/// The reverse of BindColumnValue().
+	/// </summary>
+	template<typename T>
+	void ReadColumnValue(const Column2& column, T& value)
+	{
+		if constexpr (std::is_same_v<T, std::string>)
+		{
+			value = column.getString();
+		}
+		else if constexpr (std::is_same_v<T, bool>)
+		{
+			value = column.getInt64() != 0;
+		}
+		else if constexpr (std::is_enum_v<T>)
+		{
+			value = static_cast<T>(column.getInt64());
+		}
+		else if constexpr (detail::IsOptional<T>::value)
+		{
+			if (column.isNull())
+				value.reset();
+			else
+				ReadColumnValue(column, value.emplace());
+		}
+		else
+		{
+			value = column;
+		}
+	}
+
+	/// <summary>
+	/// Maps a table's columns to the members of a struct, once. The SQL for writing a row and for
+	/// reading one back by its primary key is generated up front and run through a StatementCache,
+	/// so storing or reading a row only binds parameters.
+	/// </summary>
+	template<typename TRow>
+	class RowMapping
+	{
+	public:
+		explicit RowMapping(const TableDefinition& table) :
+			m_TableName(table.GetTableName())
+		{
+		}
+
+		/// <summary>
+		/// Maps a column straight to a member (of TRow or one of its bases).
+		/// </summary>
+		template<typename TMember, typename TBase>
+		RowMapping& Column(const ColumnDefinition& column, TMember TBase::* member)
+		{
+			return Column(column,
+				[member](const TRow& row) -> const TMember& { return row.*member; },
+				[member](TRow& row, const Column2& value) { ReadColumnValue(value, row.*member); });
+		}
+
+		/// <summary>
+		/// Maps a column through functions that convert to and from what is stored.
+		/// </summary>
+		template<typename TGetFunc, typename TSetFunc>
+		RowMapping& Column(const ColumnDefinition& column, TGetFunc getFunc, TSetFunc setFunc)
+		{
+			m_Fields.push_back(Field
+				{
+					.m_Column = &column,
+					.m_Bind = [&column, getFunc](SQLite::Statement& statement, int index, const TRow& row)
+					{
+						BindColumnValue(statement, index, column, getFunc(row));
+					},
+					.m_Read = std::move(setFunc),
+				});
+
+			if (column.m_Flags & ColumnFlags::PrimaryKey)
+				m_KeyField = m_Fields.size() - 1;
+
+			std::vector<const ColumnDefinition*> columns;
+			for (const Field& field : m_Fields)
+				columns.push_back(field.m_Column);
+
+			m_ReplaceQuery = CreateInsertIntoQuery(m_TableName, columns, InsertIntoConstraintResolver::Replace);
+			if (m_KeyField)
+				m_SelectQuery = CreateSelectQuery(m_TableName, columns, *m_Fields[*m_KeyField].m_Column);
+
+			return *this;
+		}
+
+		/// <summary>
+		/// Inserts the row, replacing any existing row with the same primary key.
+		/// </summary>
+		void Replace(StatementCache& statements, const TRow& row) const
+		{
+			SQLite::Statement& statement = statements.Get(m_ReplaceQuery);
+			for (size_t i = 0; i < m_Fields.size(); i++)
+				m_Fields[i].m_Bind(statement, int(i + 1), row);
+
+			statement.exec();
+		}
+
+		/// <summary>
+		/// Looks up the row with the primary key already set in row, and fills in everything else.
+		/// </summary>
+		[[nodiscard]] bool TrySelect(StatementCache& statements, TRow& row) const
+		{
+			assert(m_KeyField);
+
+			SQLite::Statement& statement = statements.Get(m_SelectQuery);
+			m_Fields[*m_KeyField].m_Bind(statement, 1, row);
+
+			// Don't hold the read transaction open until the next lookup, even if reading a column throws.
+			// tryReset() because reset() rethrows the error of a failed step.
+			const mh::scope_exit resetStatement([&statement] { statement.tryReset(); });
+
+			if (!statement.executeStep())
+				return false;
+
+			for (size_t i = 0; i < m_Fields.size(); i++)
+			{
+				if (i != *m_KeyField)
+					m_Fields[i].m_Read(row, Column2(statement.getColumn(int(i))));
+			}
+
+			return true;
+		}
+
+	private:
+		struct Field
+		{
+			const ColumnDefinition* m_Column;
+			std::function<void(SQLite::Statement& statement, int index, const TRow& row)> m_Bind;
+			std::function<void(TRow& row, const Column2& value)> m_Read;
+		};
+
+		std::string m_TableName;
+		std::vector<Field> m_Fields;
+		std::optional<size_t> m_KeyField;
+		std::string m_ReplaceQuery;
+		std::string m_SelectQuery;
+	};
 }
@@ -7,25 +7,42 @@
 
 #include <mh/error/ensure.hpp>
 #include <mh/concurrency/thread_sentinel.hpp>
+#include <mh/raii/scope_exit.hpp>
 #include <mh/types/enum_class_bit_ops.hpp>
+#include <nlohmann/json.hpp>
 #include <sqlite3.h>
 #include <SQLiteCpp/SQLiteCpp.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
 
 using namespace tf2_bot_detector;
 using namespace tf2_bot_detector::DB;
 
 namespace
 {
+	struct BASETABLE_EXPIRABLE;
+
 	class TempDB final : public ITempDB
 	{
 	public:
 		TempDB();
+		~TempDB();
 
 		void Store(const AccountAgeInfo& info) override;
 		bool TryGet(AccountAgeInfo& info) const override;
 		void GetNearestAccountAgeInfos(SteamID id, std::optional<AccountAgeInfo>& lower, std::optional<AccountAgeInfo>& upper) const override;
+		void ForEachAccountAgeInfo(const std::function<void(const AccountAgeInfo& info)>& func) const override;
+		void StoreAccountAges(std::vector<AccountAgeIndex::Sample> samples) override;
 
 		void Store(const LogsTFCacheInfo& info) override;
 		bool TryGet(LogsTFCacheInfo& info) const override;
@@ -33,11 +50,85 @@ namespace
 		void Store(const AccountInventorySizeInfo& info) override;
 		bool TryGet(AccountInventorySizeInfo& info) const override;
 
+		void Store(const PlayerSummaryCacheInfo& info) override;
+		bool TryGet(PlayerSummaryCacheInfo& info) const override;
+
+		void Store(const PlayerBansCacheInfo& info) override;
+		bool TryGet(PlayerBansCacheInfo& info) const override;
+
+		void Store(const PlayerSourceBansCacheInfo& info) override;
+		bool TryGet(PlayerSourceBansCacheInfo& info) const override;
+
+		void Store(const TF2PlaytimeCacheInfo& info) override;
+		bool TryGet(TF2PlaytimeCacheInfo& info) const override;
+
+		void SetSizeBudget(uint64_t bytes) override;
+
 	private:
-		static constexpr size_t DB_VERSION = 4;
+		static constexpr size_t DB_VERSION = 6;
+
+		// How long the writer thread collects writes before committing them together
+		static constexpr auto WRITE_BATCH_TIME = 250ms;
+
+		// How long the writer thread has to go without any writes before it does some maintenance
+		static constexpr auto MAINTENANCE_IDLE_TIME = 5s;
+		static constexpr auto EVICTION_INTERVAL = 30min;
+		static constexpr int VACUUM_PAGES_PER_STEP = 256;
+		static constexpr int64_t MIN_EVICTION_BATCH_ROWS = 1000;
+
+		// Imported account ages are written this many at a time, about a second's worth
+		static constexpr size_t ACCOUNT_AGES_WRITE_BATCH_ROWS = 500'000;
+
+		// Stale rows are still shown while fresh data is fetched, so they're only evicted once they've
+		// gone unused for this many times as long as they stay fresh, and never sooner than a week
+		static constexpr int EXPIRED_EVICTION_LIVE_TIMES = 4;
+		static constexpr auto MIN_EXPIRED_EVICTION_TIME = day_t(7);
+
+		// Reads only update a row's last access time once it is this far out of date, so looking
+		// something up doesn't queue a write every time
+		static constexpr auto ACCESS_TIME_GRANULARITY = 1h;
+
+		// Space an account age takes up, counting its UNIQUE index. Only used when SQLite was built
+		// without the dbstat table, so the cache tables can't be measured directly.
+		static constexpr int64_t ACCOUNT_AGE_ROW_BYTES = 32;
+
 		void Connect();
 
-		std::optional<SQLite::Database> m_Connection;
+		using WriteFunc = std::function<void(StatementCache& statements)>;
+		void QueueWrite(WriteFunc func) const;
+		void QueueAccountAgesWrite(std::shared_ptr<const std::vector<AccountAgeIndex::Sample>> samples, size_t offset) const;
+		void WriterThreadFunc();
+		void RunWrites(StatementCache& statements, const std::vector<WriteFunc>& writes);
+
+		template<typename TInfo>
+		bool TrySelectAndMarkAccessed(const RowMapping<TInfo>& mapping, const BASETABLE_EXPIRABLE& table, TInfo& info) const;
+		time_point_t GetLastUsedTime(const BASETABLE_EXPIRABLE& table, const SteamID& id) const;
+		void MarkAccessed(const BASETABLE_EXPIRABLE& table, const SteamID& id, time_point_t now) const;
+
+		void RunMaintenance(SQLite::Database& db);
+		size_t EvictExpired(SQLite::Database& db, time_point_t now);
+		size_t EvictLeastRecentlyUsed(SQLite::Database& db, uint64_t sizeBudget);
+
+		// Only used by the writer thread once it is running
+		std::optional<SQLite::Database> m_WriteConnection;
+
+		// WAL lets readers keep going while the writer thread is in the middle of a transaction
+		std::optional<SQLite::Database> m_ReadConnection;
+
+		// Compiled once and reused for every lookup on m_ReadConnection
+		mutable std::mutex m_ReadMutex;
+		mutable std::optional<StatementCache> m_ReadStatements;
+
+		mutable std::mutex m_WriteMutex;
+		mutable std::condition_variable m_WriteCV;
+		mutable std::vector<WriteFunc> m_PendingWrites;
+		bool m_StopWriter = false;
+
+		std::atomic<uint64_t> m_SizeBudget = 0; // No budget if 0
+		std::atomic_bool m_EvictionRequested = false;
+		time_point_t m_NextEvictionTime{}; // Writer thread only
+
+		std::thread m_WriterThread;
 	};
 
 	static std::string CreateDBPath()
@@ -59,6 +150,15 @@ namespace
 		using BASETABLE::BASETABLE;
 
 		const ColumnDefinition COL_LAST_UPDATE_TIME = Column("LastUpdateTime", ColumnType::Integer, ColumnFlags::NotNull);
+
+		// Null until the row is first read after being stored
+		const ColumnDefinition COL_LAST_ACCESS_TIME = Column("LastAccessTime", ColumnType::Integer);
+
+		// When the row was last stored or read, whichever came later
+		std::string GetLastUsedExpression() const
+		{
+			return mh::format(R"SQL(max("{}", ifnull("{}", 0)))SQL", COL_LAST_UPDATE_TIME.m_Name, COL_LAST_ACCESS_TIME.m_Name);
+		}
 	};
 
 	struct TABLE_ACCOUNT_AGES final : BASETABLE
@@ -86,32 +186,120 @@ namespace
 
 	} static const s_TableInventorySize;
 
+	struct TABLE_PLAYER_SUMMARY_CACHE final : BASETABLE_EXPIRABLE
+	{
+		TABLE_PLAYER_SUMMARY_CACHE() : BASETABLE_EXPIRABLE("TABLE_PLAYER_SUMMARY_CACHE") {}
+
+		const ColumnDefinition COL_NICKNAME = Column("Nickname", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_REAL_NAME = Column("RealName", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_AVATAR_HASH = Column("AvatarHash", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_PROFILE_URL = Column("ProfileURL", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_PERSONA_STATE = Column("PersonaState", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_VISIBILITY = Column("Visibility", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_PROFILE_CONFIGURED = Column("ProfileConfigured", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_COMMENT_PERMISSIONS = Column("CommentPermissions", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_CREATION_TIME = Column("CreationTime", ColumnType::Integer);
+		const ColumnDefinition COL_LAST_LOGOFF = Column("LastLogOff", ColumnType::Integer);
+
+	} static const s_TablePlayerSummaryCache;
+
+	struct TABLE_PLAYER_BANS_CACHE final : BASETABLE_EXPIRABLE
+	{
+		TABLE_PLAYER_BANS_CACHE() : BASETABLE_EXPIRABLE("TABLE_PLAYER_BANS_CACHE") {}
+
+		const ColumnDefinition COL_COMMUNITY_BANNED = Column("CommunityBanned", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_ECONOMY_BAN = Column("EconomyBan", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_VAC_BAN_COUNT = Column("VACBanCount", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_GAME_BAN_COUNT = Column("GameBanCount", ColumnType::Integer, ColumnFlags::NotNull);
+
+		// As of LastUpdateTime
+		const ColumnDefinition COL_TIME_SINCE_LAST_BAN = Column("TimeSinceLastBan", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TablePlayerBansCache;
+
+	struct TABLE_SOURCEBANS_CACHE final : BASETABLE_EXPIRABLE
+	{
+		TABLE_SOURCEBANS_CACHE() : BASETABLE_EXPIRABLE("TABLE_SOURCEBANS_CACHE") {}
+
+		// JSON array, in the same format steamhistory.net sends them
+		const ColumnDefinition COL_BANS = Column("Bans", ColumnType::Text, ColumnFlags::NotNull);
+
+	} static const s_TableSourceBansCache;
+
+	struct TABLE_TF2_PLAYTIME_CACHE final : BASETABLE_EXPIRABLE
+	{
+		TABLE_TF2_PLAYTIME_CACHE() : BASETABLE_EXPIRABLE("TABLE_TF2_PLAYTIME_CACHE") {}
+
+		const ColumnDefinition COL_PLAYTIME = Column("Playtime", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TableTF2PlaytimeCache;
+
+	struct ExpirableTable
+	{
+		const BASETABLE_EXPIRABLE& m_Table;
+		duration_t m_LiveTime;
+	};
+
+	// Only caches of API responses, so anything in them can be fetched again if evicted
+	const ExpirableTable s_ExpirableTables[] =
+	{
+		{ s_TableLogsTFCache, LogsTFCacheInfo().GetCacheLiveTime() },
+		{ s_TableInventorySize, AccountInventorySizeInfo().GetCacheLiveTime() },
+		{ s_TablePlayerSummaryCache, PlayerSummaryCacheInfo().GetCacheLiveTime() },
+		{ s_TablePlayerBansCache, PlayerBansCacheInfo().GetCacheLiveTime() },
+		{ s_TableSourceBansCache, PlayerSourceBansCacheInfo().GetCacheLiveTime() },
+		{ s_TableTF2PlaytimeCache, TF2PlaytimeCacheInfo().GetCacheLiveTime() },
+	};
+
 	TempDB::TempDB() try
 	{
 		Connect();
 
 		// Delete and recreate the DB if its an old version
-		if (const auto currentUserVersion = m_Connection->execAndGet("PRAGMA user_version").getInt();
+		if (const auto currentUserVersion = m_WriteConnection->execAndGet("PRAGMA user_version").getInt();
 			currentUserVersion != DB_VERSION)
 		{
 			LogWarning("Current {} version = {}. Deleting and recreating...", CreateDBPath(), currentUserVersion);
-			m_Connection.reset();
+			m_WriteConnection.reset();
 			std::filesystem::remove(CreateDBPath());
 			Connect();
-			m_Connection->exec(mh::format("PRAGMA user_version = {}", DB_VERSION)); // TODO check current user_version and delete if different
+			m_WriteConnection->exec("PRAGMA auto_vacuum = INCREMENTAL;"); // Only takes effect before any tables are created
+			m_WriteConnection->exec(mh::format("PRAGMA user_version = {}", DB_VERSION)); // TODO check current user_version and delete if different
 		}
 
-		m_Connection->exec("PRAGMA journal_mode = WAL;");
+		m_WriteConnection->exec("PRAGMA journal_mode = WAL;");
+		m_WriteConnection->exec("PRAGMA synchronous = NORMAL;"); // Only a cache, losing the last batch to a power cut is fine
+
+		CreateTable(m_WriteConnection.value(), s_TableAccountAges, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TableLogsTFCache, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TableInventorySize, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TablePlayerSummaryCache, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TablePlayerBansCache, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TableSourceBansCache, CreateTableFlags::IfNotExists);
+		CreateTable(m_WriteConnection.value(), s_TableTF2PlaytimeCache, CreateTableFlags::IfNotExists);
 
-		CreateTable(m_Connection.value(), s_TableAccountAges, CreateTableFlags::IfNotExists);
-		CreateTable(m_Connection.value(), s_TableLogsTFCache, CreateTableFlags::IfNotExists);
-		CreateTable(m_Connection.value(), s_TableInventorySize, CreateTableFlags::IfNotExists);
+		m_ReadConnection.emplace(CreateDBPath(), SQLite::OPEN_READONLY | SQLite::OPEN_FULLMUTEX);
+		m_ReadStatements.emplace(m_ReadConnection.value());
+
+		m_WriterThread = std::thread(&TempDB::WriterThreadFunc, this);
 	}
 	catch (...)
 	{
 		LogException();
 		throw;
 	}
+
+	TempDB::~TempDB()
+	{
+		// The writer thread commits whatever is still queued before it exits
+		{
+			std::lock_guard lock(m_WriteMutex);
+			m_StopWriter = true;
+		}
+
+		m_WriteCV.notify_all();
+		m_WriterThread.join();
+	}
 }
 
 namespace tf2_bot_detector::DB
@@ -142,39 +330,89 @@ namespace tf2_bot_detector::DB
 			return SteamID(column.getUInt(), SteamAccountType::Individual);
 		}
 	};
+
+	template<>
+	struct ColumnDataSerializer<duration_t>
+	{
+		static int64_t Serialize(duration_t duration)
+		{
+			return std::chrono::duration_cast<std::chrono::seconds>(duration).count();
+		}
+		static duration_t Deserialize(const SQLite::Column& column)
+		{
+			return std::chrono::seconds(column.getInt64());
+		}
+	};
 }
 
 namespace
 {
-	void TempDB::Store(const AccountAgeInfo& info) try
-	{
-		ReplaceInto(m_Connection.value(), s_TableAccountAges.GetTableName(),
+	// Built once, so Store()/TryGet() only bind parameters to already compiled statements
+	const auto s_AccountAgesMapping = RowMapping<AccountAgeInfo>(s_TableAccountAges)
+		.Column(s_TableAccountAges.COL_ACCOUNT_ID, &AccountAgeInfo::m_SteamID)
+		.Column(s_TableAccountAges.COL_CREATION_TIME, &AccountAgeInfo::m_CreationTime);
+
+	const auto s_LogsTFCacheMapping = RowMapping<LogsTFCacheInfo>(s_TableLogsTFCache)
+		.Column(s_TableLogsTFCache.COL_ACCOUNT_ID, &LogsTFCacheInfo::m_ID)
+		.Column(s_TableLogsTFCache.COL_LAST_UPDATE_TIME, &LogsTFCacheInfo::m_LastCacheUpdateTime)
+		.Column(s_TableLogsTFCache.COL_LOG_COUNT, &LogsTFCacheInfo::m_LogsCount);
+
+	const auto s_InventorySizeMapping = RowMapping<AccountInventorySizeInfo>(s_TableInventorySize)
+		.Column(s_TableInventorySize.COL_ACCOUNT_ID, &AccountInventorySizeInfo::m_SteamID)
+		.Column(s_TableInventorySize.COL_LAST_UPDATE_TIME, &AccountInventorySizeInfo::m_LastCacheUpdateTime)
+		.Column(s_TableInventorySize.COL_ITEM_COUNT, &AccountInventorySizeInfo::m_Items)
+		.Column(s_TableInventorySize.COL_SLOT_COUNT, &AccountInventorySizeInfo::m_Slots);
+
+	const auto s_PlayerSummaryCacheMapping = RowMapping<PlayerSummaryCacheInfo>(s_TablePlayerSummaryCache)
+		.Column(s_TablePlayerSummaryCache.COL_ACCOUNT_ID, &PlayerSummaryCacheInfo::m_SteamID)
+		.Column(s_TablePlayerSummaryCache.COL_LAST_UPDATE_TIME, &PlayerSummaryCacheInfo::m_LastCacheUpdateTime)
+		.Column(s_TablePlayerSummaryCache.COL_NICKNAME, &PlayerSummaryCacheInfo::m_Nickname)
+		.Column(s_TablePlayerSummaryCache.COL_REAL_NAME, &PlayerSummaryCacheInfo::m_RealName)
+		.Column(s_TablePlayerSummaryCache.COL_AVATAR_HASH, &PlayerSummaryCacheInfo::m_AvatarHash)
+		.Column(s_TablePlayerSummaryCache.COL_PROFILE_URL, &PlayerSummaryCacheInfo::m_ProfileURL)
+		.Column(s_TablePlayerSummaryCache.COL_PERSONA_STATE, &PlayerSummaryCacheInfo::m_Status)
+		.Column(s_TablePlayerSummaryCache.COL_VISIBILITY, &PlayerSummaryCacheInfo::m_Visibility)
+		.Column(s_TablePlayerSummaryCache.COL_PROFILE_CONFIGURED, &PlayerSummaryCacheInfo::m_ProfileConfigured)
+		.Column(s_TablePlayerSummaryCache.COL_COMMENT_PERMISSIONS, &PlayerSummaryCacheInfo::m_CommentPermissions)
+		.Column(s_TablePlayerSummaryCache.COL_CREATION_TIME, &PlayerSummaryCacheInfo::m_CreationTime)
+		.Column(s_TablePlayerSummaryCache.COL_LAST_LOGOFF, &PlayerSummaryCacheInfo::m_LastLogOff);
+
+	const auto s_PlayerBansCacheMapping = RowMapping<PlayerBansCacheInfo>(s_TablePlayerBansCache)
+		.Column(s_TablePlayerBansCache.COL_ACCOUNT_ID, &PlayerBansCacheInfo::m_SteamID)
+		.Column(s_TablePlayerBansCache.COL_LAST_UPDATE_TIME, &PlayerBansCacheInfo::m_LastCacheUpdateTime)
+		.Column(s_TablePlayerBansCache.COL_COMMUNITY_BANNED, &PlayerBansCacheInfo::m_CommunityBanned)
+		.Column(s_TablePlayerBansCache.COL_ECONOMY_BAN, &PlayerBansCacheInfo::m_EconomyBan)
+		.Column(s_TablePlayerBansCache.COL_VAC_BAN_COUNT, &PlayerBansCacheInfo::m_VACBanCount)
+		.Column(s_TablePlayerBansCache.COL_GAME_BAN_COUNT, &PlayerBansCacheInfo::m_GameBanCount)
+		.Column(s_TablePlayerBansCache.COL_TIME_SINCE_LAST_BAN, &PlayerBansCacheInfo::m_TimeSinceLastBan);
+
+	const auto s_SourceBansCacheMapping = RowMapping<PlayerSourceBansCacheInfo>(s_TableSourceBansCache)
+		.Column(s_TableSourceBansCache.COL_ACCOUNT_ID, &PlayerSourceBansCacheInfo::m_SteamID)
+		.Column(s_TableSourceBansCache.COL_LAST_UPDATE_TIME, &PlayerSourceBansCacheInfo::m_LastCacheUpdateTime)
+		.Column(s_TableSourceBansCache.COL_BANS,
+			[](const PlayerSourceBansCacheInfo& info) { return nlohmann::json(info.m_SourceBans).dump(); },
+			[](PlayerSourceBansCacheInfo& info, const Column2& value)
 			{
-				{ s_TableAccountAges.COL_ACCOUNT_ID, info.m_SteamID },
-				{ s_TableAccountAges.COL_CREATION_TIME, info.m_CreationTime },
+				info.m_SourceBans = nlohmann::json::parse(value.getString()).get<SteamHistoryAPI::PlayerSourceBans>();
 			});
-	}
-	catch (...)
+
+	const auto s_TF2PlaytimeCacheMapping = RowMapping<TF2PlaytimeCacheInfo>(s_TableTF2PlaytimeCache)
+		.Column(s_TableTF2PlaytimeCache.COL_ACCOUNT_ID, &TF2PlaytimeCacheInfo::m_SteamID)
+		.Column(s_TableTF2PlaytimeCache.COL_LAST_UPDATE_TIME, &TF2PlaytimeCacheInfo::m_LastCacheUpdateTime)
+		.Column(s_TableTF2PlaytimeCache.COL_PLAYTIME, &TF2PlaytimeCacheInfo::m_Playtime);
+}
+
+namespace
+{
+	void TempDB::Store(const AccountAgeInfo& info)
 	{
-		LogException();
-		throw;
+		QueueWrite([info](StatementCache& statements) { s_AccountAgesMapping.Replace(statements, info); });
 	}
 
 	bool TempDB::TryGet(AccountAgeInfo& info) const try
 	{
-		auto& db = const_cast<SQLite::Database&>(m_Connection.value());
-
-		auto query = SelectStatementBuilder(s_TableAccountAges.GetTableName())
-			.Where(s_TableAccountAges.COL_ACCOUNT_ID == info.m_SteamID)
-			.Run(db);
-
-		if (query.executeStep())
-		{
-			info.m_CreationTime = query.getColumn(s_TableAccountAges.COL_CREATION_TIME);
-			return true;
-		}
-
-		return false;
+		std::lock_guard lock(m_ReadMutex);
+		return s_AccountAgesMapping.TrySelect(m_ReadStatements.value(), info);
 	}
 	catch (...)
 	{
@@ -184,7 +422,7 @@ namespace
 
 	void TempDB::GetNearestAccountAgeInfos(SteamID id, std::optional<AccountAgeInfo>& lower, std::optional<AccountAgeInfo>& upper) const
 	{
-		auto queryStr = mh::format(R"SQL(
+		static const auto queryStr = mh::format(R"SQL(
 SELECT max({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_AccountAges} WHERE {col_AccountID} <= $steamID
 UNION ALL
 SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_AccountAges} WHERE {col_AccountID} >= $steamID)SQL",
@@ -193,14 +431,18 @@ SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_Acc
 			mh::fmtarg("col_CreationTime", s_TableAccountAges.COL_CREATION_TIME.m_Name),
 			mh::fmtarg("tbl_AccountAges", s_TableAccountAges.GetTableName()));
 
-		Statement2 query(SQLite::Statement(const_cast<SQLite::Database&>(m_Connection.value()), queryStr));
+		std::lock_guard lock(m_ReadMutex);
+		auto& query = m_ReadStatements->Get(queryStr);
 		query.bind("$steamID", id.GetAccountID());
 
+		// Don't leave the read transaction open after returning early on an exact match
+		const mh::scope_exit resetQuery([&query] { query.tryReset(); });
+
 		const auto DeserializeAccountInfo = [&]()
 		{
 			AccountAgeInfo info;
-			info.m_SteamID = query.getColumn(s_TableAccountAges.COL_ACCOUNT_ID);
-			info.m_CreationTime = query.getColumn(s_TableAccountAges.COL_CREATION_TIME);
+			info.m_SteamID = Column2(query.getColumn(s_TableAccountAges.COL_ACCOUNT_ID.m_Name));
+			info.m_CreationTime = Column2(query.getColumn(s_TableAccountAges.COL_CREATION_TIME.m_Name));
 			return info;
 		};
 
@@ -223,74 +465,383 @@ SELECT min({col_AccountID}) AS {col_AccountID}, {col_CreationTime} FROM {tbl_Acc
 		}
 	}
 
-	void TempDB::Connect()
+	void TempDB::ForEachAccountAgeInfo(const std::function<void(const AccountAgeInfo& info)>& func) const try
 	{
-		assert(!m_Connection.has_value());
-		m_Connection.emplace(CreateDBPath(), SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE | SQLite::OPEN_FULLMUTEX);
+		auto query = SelectStatementBuilder(s_TableAccountAges.GetTableName())
+			.Run(m_ReadConnection.value());
+
+		AccountAgeInfo info;
+		while (query.executeStep())
+		{
+			info.m_SteamID = query.getColumn(s_TableAccountAges.COL_ACCOUNT_ID);
+			info.m_CreationTime = query.getColumn(s_TableAccountAges.COL_CREATION_TIME);
+			func(info);
+		}
+	}
+	catch (...)
+	{
+		LogException();
+		throw;
 	}
 
-	void TempDB::Store(const LogsTFCacheInfo& info) try
+	void TempDB::StoreAccountAges(std::vector<AccountAgeIndex::Sample> samples)
 	{
-		ReplaceInto(m_Connection.value(), s_TableLogsTFCache.GetTableName(),
+		if (!samples.empty())
+			QueueAccountAgesWrite(std::make_shared<const std::vector<AccountAgeIndex::Sample>>(std::move(samples)), 0);
+	}
+
+	void TempDB::QueueAccountAgesWrite(std::shared_ptr<const std::vector<AccountAgeIndex::Sample>> samples, size_t offset) const
+	{
+		QueueWrite([this, samples, offset](StatementCache& statements)
 			{
-				{ s_TableLogsTFCache.COL_ACCOUNT_ID, info.GetSteamID() },
-				{ s_TableLogsTFCache.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
-				{ s_TableLogsTFCache.COL_LOG_COUNT, info.m_LogsCount }
+				const size_t end = std::min(samples->size(), offset + ACCOUNT_AGES_WRITE_BATCH_ROWS);
+
+				AccountAgeInfo info;
+				for (size_t i = offset; i < end; i++)
+				{
+					info.m_SteamID = SteamID((*samples)[i].m_AccountID, SteamAccountType::Individual);
+					info.m_CreationTime = (*samples)[i].GetCreationTime();
+					s_AccountAgesMapping.Replace(statements, info);
+				}
+
+				// Queue the rest behind whatever came in meanwhile, instead of holding up every
+				// other write until the whole import is done
+				if (end < samples->size())
+					QueueAccountAgesWrite(samples, end);
 			});
 	}
+
+	void TempDB::Connect()
+	{
+		assert(!m_WriteConnection.has_value());
+		m_WriteConnection.emplace(CreateDBPath(), SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE | SQLITE_OPEN_NOMUTEX);
+	}
+
+	void TempDB::QueueWrite(WriteFunc func) const
+	{
+		{
+			std::lock_guard lock(m_WriteMutex);
+			m_PendingWrites.push_back(std::move(func));
+		}
+
+		m_WriteCV.notify_all();
+	}
+
+	void TempDB::WriterThreadFunc()
+	{
+		// Every Store() overload runs the same few queries, so they only get compiled once
+		StatementCache statements(m_WriteConnection.value());
+		std::vector<WriteFunc> writes;
+
+		std::unique_lock lock(m_WriteMutex);
+		while (true)
+		{
+			if (!m_WriteCV.wait_for(lock, MAINTENANCE_IDLE_TIME, [&] { return m_StopWriter || !m_PendingWrites.empty(); }))
+			{
+				// Nothing to write for a while, so there is time to clean up
+				lock.unlock();
+				RunMaintenance(statements.GetDatabase());
+				lock.lock();
+				continue;
+			}
+
+			if (m_PendingWrites.empty())
+				break; // Stopping, and nothing left to write
+
+			// Give the rest of a burst (a whole lobby joining) a chance to join this transaction
+			m_WriteCV.wait_for(lock, WRITE_BATCH_TIME, [&] { return m_StopWriter; });
+
+			writes.swap(m_PendingWrites);
+			lock.unlock();
+			RunWrites(statements, writes);
+			writes.clear();
+			lock.lock();
+		}
+	}
+
+	void TempDB::RunWrites(StatementCache& statements, const std::vector<WriteFunc>& writes) try
+	{
+		SQLite::Transaction transaction(statements.GetDatabase());
+
+		for (const WriteFunc& write : writes)
+		{
+			try
+			{
+				write(statements);
+			}
+			catch (...)
+			{
+				// Shouldn't take the rest of the batch down with it
+				LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write a queued row to the temp DB");
+			}
+		}
+
+		transaction.commit();
+	}
 	catch (...)
 	{
-		LogException();
-		throw;
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to write {} queued rows to the temp DB", writes.size());
 	}
 
-	bool TempDB::TryGet(LogsTFCacheInfo& info) const
+	void TempDB::SetSizeBudget(uint64_t bytes)
 	{
-		auto query = SelectStatementBuilder(s_TableLogsTFCache.GetTableName())
-			.Where(s_TableLogsTFCache.COL_ACCOUNT_ID == info.m_ID)
-			.Run(m_Connection.value());
+		if (m_SizeBudget.exchange(bytes) != bytes)
+			m_EvictionRequested = true;
+	}
 
-		if (query.executeStep())
+	template<typename TInfo>
+	bool TempDB::TrySelectAndMarkAccessed(const RowMapping<TInfo>& mapping, const BASETABLE_EXPIRABLE& table, TInfo& info) const
+	{
+		const auto now = tfbd_clock_t::now();
 		{
-			info.m_LastCacheUpdateTime = query.getColumn(s_TableLogsTFCache.COL_LAST_UPDATE_TIME);
-			info.m_LogsCount = query.getColumn(s_TableLogsTFCache.COL_LOG_COUNT);
-			return true;
+			std::lock_guard lock(m_ReadMutex);
+			if (!mapping.TrySelect(m_ReadStatements.value(), info))
+				return false;
+
+			if (GetLastUsedTime(table, info.GetSteamID()) > (now - ACCESS_TIME_GRANULARITY))
+				return true;
 		}
 
-		return false;
+		MarkAccessed(table, info.GetSteamID(), now);
+		return true;
 	}
 
-	void TempDB::Store(const AccountInventorySizeInfo& info) try
+	// m_ReadMutex must be held
+	time_point_t TempDB::GetLastUsedTime(const BASETABLE_EXPIRABLE& table, const SteamID& id) const
 	{
-		ReplaceInto(m_Connection.value(), s_TableInventorySize.GetTableName(),
+		auto& statement = m_ReadStatements->Get(mh::format(R"SQL(SELECT {} FROM "{}" WHERE "{}" == ?1)SQL",
+			table.GetLastUsedExpression(), table.GetTableName(), table.COL_ACCOUNT_ID.m_Name));
+
+		const mh::scope_exit resetStatement([&statement] { statement.tryReset(); });
+
+		BindColumnData(statement, 1, ColumnData(table.COL_ACCOUNT_ID, id));
+		if (!statement.executeStep())
+			return {};
+
+		return Column2(statement.getColumn(0));
+	}
+
+	void TempDB::MarkAccessed(const BASETABLE_EXPIRABLE& table, const SteamID& id, time_point_t now) const
+	{
+		QueueWrite([&table, id, now](StatementCache& statements)
 			{
-				{ s_TableInventorySize.COL_ACCOUNT_ID, info.GetSteamID() },
-				{ s_TableInventorySize.COL_LAST_UPDATE_TIME, info.m_LastCacheUpdateTime },
-				{ s_TableInventorySize.COL_ITEM_COUNT, info.m_Items },
-				{ s_TableInventorySize.COL_SLOT_COUNT, info.m_Slots },
+				auto& statement = statements.Get(mh::format(R"SQL(UPDATE "{}" SET "{}" = ?1 WHERE "{}" == ?2)SQL",
+					table.GetTableName(), table.COL_LAST_ACCESS_TIME.m_Name, table.COL_ACCOUNT_ID.m_Name));
+
+				BindColumnData(statement, 1, ColumnData(table.COL_LAST_ACCESS_TIME, now));
+				BindColumnData(statement, 2, ColumnData(table.COL_ACCOUNT_ID, id));
+				statement.exec();
 			});
 	}
+
+	void TempDB::RunMaintenance(SQLite::Database& db) try
+	{
+		const auto now = tfbd_clock_t::now();
+		if (m_EvictionRequested.exchange(false) || now >= m_NextEvictionTime)
+		{
+			m_NextEvictionTime = now + EVICTION_INTERVAL;
+
+			SQLite::Transaction transaction(db);
+			const size_t expiredCount = EvictExpired(db, now);
+			const size_t lruCount = EvictLeastRecentlyUsed(db, m_SizeBudget);
+			transaction.commit();
+
+			if (expiredCount > 0 || lruCount > 0)
+				Log("Evicted {} expired and {} least recently used rows from the temp DB", expiredCount, lruCount);
+		}
+
+		// Hand the pages freed by evictions back a few at a time, so a big cleanup doesn't hold up
+		// writes that come in while it is going. 2 == INCREMENTAL.
+		if (db.execAndGet("PRAGMA auto_vacuum").getInt() == 2 && db.execAndGet("PRAGMA freelist_count").getInt64() > 0)
+		{
+			db.exec(mh::format("PRAGMA incremental_vacuum({});", VACUUM_PAGES_PER_STEP));
+
+			// The file only shrinks once the WAL is checkpointed
+			if (db.execAndGet("PRAGMA freelist_count").getInt64() == 0)
+				db.exec("PRAGMA wal_checkpoint(TRUNCATE);");
+		}
+	}
 	catch (...)
 	{
-		LogException();
-		throw;
+		LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to clean up the temp DB");
 	}
 
-	bool TempDB::TryGet(AccountInventorySizeInfo& info) const
+	size_t TempDB::EvictExpired(SQLite::Database& db, time_point_t now)
 	{
-		auto query = SelectStatementBuilder(s_TableInventorySize.GetTableName())
-			.Where(s_TableInventorySize.COL_ACCOUNT_ID == info.GetSteamID())
-			.Run(m_Connection.value());
+		size_t count = 0;
 
-		if (query.executeStep())
+		// Expired rows that are still being read are kept, since they're shown while fresh data is fetched
+		for (const ExpirableTable& table : s_ExpirableTables)
 		{
-			info.m_LastCacheUpdateTime = query.getColumn(s_TableInventorySize.COL_LAST_UPDATE_TIME);
-			info.m_Items = query.getColumn(s_TableInventorySize.COL_ITEM_COUNT);
-			info.m_Slots = query.getColumn(s_TableInventorySize.COL_SLOT_COUNT);
-			return true;
+			SQLite::Statement statement(db, mh::format(R"SQL(DELETE FROM "{}" WHERE {} < ?1)SQL",
+				table.m_Table.GetTableName(), table.m_Table.GetLastUsedExpression()));
+
+			const duration_t unusedTime = std::max<duration_t>(table.m_LiveTime * EXPIRED_EVICTION_LIVE_TIMES, MIN_EXPIRED_EVICTION_TIME);
+			BindColumnData(statement, 1, ColumnData(table.m_Table.COL_LAST_UPDATE_TIME, now - unusedTime));
+			count += statement.exec();
 		}
 
-		return false;
+		return count;
+	}
+
+	size_t TempDB::EvictLeastRecentlyUsed(SQLite::Database& db, uint64_t sizeBudget)
+	{
+		if (sizeBudget == 0)
+			return 0;
+
+		std::string lastUsedQuery;
+		std::string cacheTableNames;
+		for (const ExpirableTable& table : s_ExpirableTables)
+		{
+			if (!lastUsedQuery.empty())
+			{
+				lastUsedQuery.append(" UNION ALL ");
+				cacheTableNames.append(", ");
+			}
+
+			lastUsedQuery.append(mh::format(R"SQL(SELECT {} AS LastUsed FROM "{}")SQL",
+				table.m_Table.GetLastUsedExpression(), table.m_Table.GetTableName()));
+			cacheTableNames.append(mh::format("'{}'", table.m_Table.GetTableName()));
+		}
+
+		// Only the cache tables (and their indexes) count towards the budget, since account ages are
+		// never evicted. Freed pages don't count either, they're on their way out through incremental_vacuum.
+		std::optional<SQLite::Statement> cacheBytesStatement;
+		try
+		{
+			cacheBytesStatement.emplace(db, mh::format(R"SQL(SELECT sum("pgsize") FROM "dbstat" WHERE "name" IN
+	(SELECT "name" FROM "sqlite_master" WHERE "tbl_name" IN ({})))SQL", cacheTableNames));
+		}
+		catch (const SQLite::Exception& e)
+		{
+			DebugLog("dbstat is unavailable ({}), estimating the size of the temp DB cache tables", e.what());
+		}
+
+		const auto GetUsedBytes = [&]() -> uint64_t
+		{
+			if (cacheBytesStatement)
+			{
+				cacheBytesStatement->reset();
+				const int64_t bytes = cacheBytesStatement->executeStep() ? cacheBytesStatement->getColumn(0).getInt64() : 0;
+				cacheBytesStatement->reset();
+				return uint64_t(bytes);
+			}
+
+			const int64_t usedPages = db.execAndGet("PRAGMA page_count").getInt64() - db.execAndGet("PRAGMA freelist_count").getInt64();
+			const int64_t accountAgeBytes = ACCOUNT_AGE_ROW_BYTES *
+				db.execAndGet(mh::format(R"SQL(SELECT count(*) FROM "{}")SQL", s_TableAccountAges.GetTableName())).getInt64();
+
+			return uint64_t(std::max<int64_t>(0, usedPages * db.execAndGet("PRAGMA page_size").getInt64() - accountAgeBytes));
+		};
+
+		SQLite::Statement rowCountStatement(db, mh::format("SELECT count(*) FROM ({})", lastUsedQuery));
+		SQLite::Statement cutoffStatement(db, mh::format("SELECT LastUsed FROM ({}) ORDER BY LastUsed LIMIT 1 OFFSET ?1", lastUsedQuery));
+
+		size_t count = 0;
+		for (uint64_t usedBytes = GetUsedBytes(); usedBytes > sizeBudget; usedBytes = GetUsedBytes())
+		{
+			rowCountStatement.reset();
+			if (!rowCountStatement.executeStep())
+				break;
+
+			// Guess how many rows have to go from how far over budget we are. Rows don't free whole
+			// pages, so this takes a few rounds to settle.
+			const int64_t rowCount = rowCountStatement.getColumn(0).getInt64();
+			const int64_t evictCount = std::max(MIN_EVICTION_BATCH_ROWS,
+				int64_t(double(rowCount) * double(usedBytes - sizeBudget) / double(usedBytes)));
+
+			cutoffStatement.reset();
+			cutoffStatement.bind(1, evictCount - 1);
+
+			// Fewer rows left than that, so they all go
+			const int64_t cutoff = cutoffStatement.executeStep() ? cutoffStatement.getColumn(0).getInt64() : INT64_MAX;
+			cutoffStatement.reset();
+
+			size_t batchCount = 0;
+			for (const ExpirableTable& table : s_ExpirableTables)
+			{
+				SQLite::Statement statement(db, mh::format(R"SQL(DELETE FROM "{}" WHERE {} <= ?1)SQL",
+					table.m_Table.GetTableName(), table.m_Table.GetLastUsedExpression()));
+
+				statement.bind(1, cutoff);
+				batchCount += statement.exec();
+			}
+
+			if (batchCount == 0)
+				break; // Nothing left to evict
+
+			count += batchCount;
+		}
+
+		return count;
+	}
+
+	void TempDB::Store(const LogsTFCacheInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_LogsTFCacheMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(LogsTFCacheInfo& info) const
+	{
+		return TrySelectAndMarkAccessed(s_LogsTFCacheMapping, s_TableLogsTFCache, info);
+	}
+
+	void TempDB::Store(const AccountInventorySizeInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_InventorySizeMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(AccountInventorySizeInfo& info) const
+	{
+		return TrySelectAndMarkAccessed(s_InventorySizeMapping, s_TableInventorySize, info);
+	}
+}
+
+namespace
+{
+	void TempDB::Store(const PlayerSummaryCacheInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_PlayerSummaryCacheMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(PlayerSummaryCacheInfo& info) const
+	{
+		return TrySelectAndMarkAccessed(s_PlayerSummaryCacheMapping, s_TablePlayerSummaryCache, info);
+	}
+
+	void TempDB::Store(const PlayerBansCacheInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_PlayerBansCacheMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(PlayerBansCacheInfo& info) const
+	{
+		if (!TrySelectAndMarkAccessed(s_PlayerBansCacheMapping, s_TablePlayerBansCache, info))
+			return false;
+
+		// Stored as of the last update
+		info.m_TimeSinceLastBan += tfbd_clock_t::now() - info.m_LastCacheUpdateTime;
+		return true;
+	}
+
+	void TempDB::Store(const PlayerSourceBansCacheInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_SourceBansCacheMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(PlayerSourceBansCacheInfo& info) const
+	{
+		return TrySelectAndMarkAccessed(s_SourceBansCacheMapping, s_TableSourceBansCache, info);
+	}
+
+	void TempDB::Store(const TF2PlaytimeCacheInfo& info)
+	{
+		QueueWrite([info](StatementCache& statements) { s_TF2PlaytimeCacheMapping.Replace(statements, info); });
+	}
+
+	bool TempDB::TryGet(TF2PlaytimeCacheInfo& info) const
+	{
+		return TrySelectAndMarkAccessed(s_TF2PlaytimeCacheMapping, s_TableTF2PlaytimeCache, info);
 	}
 }
 
@@ -2,6 +2,8 @@
 
 #include "Networking/LogsTFAPI.h"
 #include "Networking/SteamAPI.h"
+#include "Networking/SteamHistoryAPI.h"
+#include "Util/AccountAgeIndex.h"
 #include "Clock.h"
 #include "SteamID.h"
 
@@ -9,6 +11,7 @@
 #include <mh/memory/stack_info.hpp>
 
 #include <cassert>
+#include <functional>
 #include <optional>
 
 namespace tf2_bot_detector::DB
@@ -73,6 +76,48 @@ namespace tf2_bot_detector::DB
 		duration_t GetCacheLiveTime() const override final { return day_t(7); }
 	};
 
+	struct PlayerSummaryCacheInfo final : detail::BaseCacheInfo_Expiration, SteamAPI::PlayerSummary
+	{
+		PlayerSummaryCacheInfo() = default;
+		using SteamAPI::PlayerSummary::PlayerSummary;
+		using SteamAPI::PlayerSummary::operator=;
+
+		using ICacheInfo::GetSteamID;
+		const SteamID& GetSteamID() const override { return m_SteamID; }
+
+		duration_t GetCacheLiveTime() const override final { return std::chrono::hours(1); }
+	};
+
+	struct PlayerBansCacheInfo final : detail::BaseCacheInfo_Expiration, SteamAPI::PlayerBans
+	{
+		PlayerBansCacheInfo() = default;
+		using SteamAPI::PlayerBans::PlayerBans;
+		using SteamAPI::PlayerBans::operator=;
+
+		using ICacheInfo::GetSteamID;
+		const SteamID& GetSteamID() const override { return m_SteamID; }
+
+		duration_t GetCacheLiveTime() const override final { return std::chrono::hours(6); }
+	};
+
+	struct PlayerSourceBansCacheInfo final : detail::BaseCacheInfo_SteamID, detail::BaseCacheInfo_Expiration
+	{
+		SteamHistoryAPI::PlayerSourceBans m_SourceBans;
+
+		duration_t GetCacheLiveTime() const override { return std::chrono::hours(6); }
+	};
+
+	struct TF2PlaytimeCacheInfo final : detail::BaseCacheInfo_SteamID, detail::BaseCacheInfo_Expiration
+	{
+		duration_t m_Playtime{};
+
+		duration_t GetCacheLiveTime() const override { return day_t(1); }
+	};
+
+	/// <summary>
+	/// Store() only queues the write. Queued writes are committed together on a background
+	/// thread a short while later, so TryGet() may not see them straight away.
+	/// </summary>
 	class ITempDB
 	{
 	public:
@@ -83,6 +128,13 @@ namespace tf2_bot_detector::DB
 		virtual void Store(const AccountAgeInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(AccountAgeInfo& info) const = 0;
 		virtual void GetNearestAccountAgeInfos(SteamID id, std::optional<AccountAgeInfo>& lower, std::optional<AccountAgeInfo>& upper) const = 0;
+		virtual void ForEachAccountAgeInfo(const std::function<void(const AccountAgeInfo& info)>& func) const = 0;
+
+		/// <summary>
+		/// Stores many account ages at once. Large sets are written in several transactions, so
+		/// other writes aren't held up until the whole set is done. 10 million take 20-30 seconds.
+		/// </summary>
+		virtual void StoreAccountAges(std::vector<AccountAgeIndex::Sample> samples) = 0;
 
 		virtual void Store(const LogsTFCacheInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(LogsTFCacheInfo& info) const = 0;
@@ -90,6 +142,49 @@ namespace tf2_bot_detector::DB
 		virtual void Store(const AccountInventorySizeInfo& info) = 0;
 		[[nodiscard]] virtual bool TryGet(AccountInventorySizeInfo& info) const = 0;
 
+		virtual void Store(const PlayerSummaryCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(PlayerSummaryCacheInfo& info) const = 0;
+
+		virtual void Store(const PlayerBansCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(PlayerBansCacheInfo& info) const = 0;
+
+		virtual void Store(const PlayerSourceBansCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(PlayerSourceBansCacheInfo& info) const = 0;
+
+		virtual void Store(const TF2PlaytimeCacheInfo& info) = 0;
+		[[nodiscard]] virtual bool TryGet(TF2PlaytimeCacheInfo& info) const = 0;
+
+		/// <summary>
+		/// Rows that haven't been stored or read for several times longer than they stay fresh (at
+		/// least a week) are evicted in the background. If the caches (everything but account ages)
+		/// still take up more than this many bytes, the least recently used rows go next. 0 means
+		/// no limit.
+		/// </summary>
+		virtual void SetSizeBudget(uint64_t bytes) = 0;
+
+		enum class CacheState
+		{
+			Missing,
+			Expired, // Still filled in, good enough to show while a fresh copy is fetched
+			Fresh,
+		};
+
+		template<typename TInfo>
+		[[nodiscard]] CacheState TryGetCached(TInfo& info) const
+		{
+			if (!TryGet(info))
+				return CacheState::Missing;
+
+			if constexpr (std::is_base_of_v<detail::BaseCacheInfo_Expiration, TInfo>)
+			{
+				auto elapsed = tfbd_clock_t::now() - info.m_LastCacheUpdateTime;
+				if (elapsed > info.GetCacheLiveTime())
+					return CacheState::Expired;
+			}
+
+			return CacheState::Fresh;
+		}
+
 		template<typename TInfo, typename TUpdateFunc>
 		mh::task<> GetOrUpdateAsync(TInfo& info, TUpdateFunc&& updateFunc)
 		{
@@ -100,22 +195,7 @@ namespace tf2_bot_detector::DB
 
 			constexpr bool HAS_EXPIRATION = std::is_base_of_v<detail::BaseCacheInfo_Expiration, TInfo>;
 
-			bool wantsRefresh = true;
-			if (TryGet(info))
-			{
-				if constexpr (HAS_EXPIRATION)
-				{
-					auto elapsed = tfbd_clock_t::now() - info.m_LastCacheUpdateTime;
-					if (elapsed <= info.GetCacheLiveTime())
-						wantsRefresh = false;
-				}
-				else
-				{
-					wantsRefresh = false;
-				}
-			}
-
-			if (wantsRefresh)
+			if (TryGetCached(info) != CacheState::Fresh)
 			{
 				co_await updateFunc(info);
 
@@ -1,6 +1,7 @@
 #include "DLLMain.h"
 
 #include "Application.h"
+#include "Config/ConfigWriter.h"
 #include "Tests/Tests.h"
 #include "Util/TextUtils.h"
 #include "Log.h"
@@ -91,7 +92,7 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 			else if (!strcmp(argv[i], "--run-tests"))
 			{
 #ifdef TF2BD_ENABLE_TESTS
-				return tf2_bot_detector::RunTests();
+				return tf2_bot_detector::RunTests(argc - i, argv + i); // Everything after --run-tests goes to Catch2
 #else
 				LogError("--run-tests was on the command line, but tests were not compiled in");
 #endif
@@ -167,6 +168,9 @@ TF2_BOT_DETECTOR_EXPORT int tf2_bot_detector::RunProgram(int argc, const char**
 #endif
 	}
 
+	// Everything that saves config files has been destroyed by now
+	IConfigWriter::Get().Flush();
+
 	ILogManager::GetInstance().CleanupEmptyLogs();
 
 	DebugLog("Graceful shutdown");
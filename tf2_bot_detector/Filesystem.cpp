@@ -23,6 +23,7 @@ namespace
 		std::filesystem::path ResolvePath(const std::filesystem::path& path, PathUsage usage) const override;
 		std::string ReadFile(std::filesystem::path path) const override;
 		void WriteFile(std::filesystem::path path, const void* begin, const void* end, PathUsage usage) const override;
+		void AppendFile(std::filesystem::path path, const void* begin, const void* end, PathUsage usage) const override;
 
 		std::filesystem::path GetLocalAppDataDir() const override;
 		std::filesystem::path GetRoamingAppDataDir() const override;
@@ -232,6 +233,27 @@ catch (...)
 	throw;
 }
 
+void Filesystem::AppendFile(std::filesystem::path path, const void* begin, const void* end, PathUsage usage) const try
+{
+	path = ResolvePath(path, usage);
+
+	// Create any missing directories
+	if (auto folderPath = mh::copy(path).remove_filename(); std::filesystem::create_directories(folderPath))
+		DebugLog("Created one or more directories in the path {}", folderPath);
+
+	std::ofstream file;
+	file.exceptions(std::ios::badbit | std::ios::failbit);
+	file.open(path, std::ios::binary | std::ios::app);
+
+	const auto bytes = uintptr_t(end) - uintptr_t(begin);
+	file.write(reinterpret_cast<const char*>(begin), bytes);
+}
+catch (...)
+{
+	LogException("Filename: {}", path);
+	throw;
+}
+
 std::filesystem::path Filesystem::GetLocalAppDataDir() const
 {
 	EnsureInit();
@@ -41,6 +41,7 @@ namespace tf2_bot_detector
 		//virtual std::fstream OpenFile(const std::filesystem::path& path) = 0;
 		virtual std::string ReadFile(std::filesystem::path path) const = 0;
 		virtual void WriteFile(std::filesystem::path path, const void* begin, const void* end, PathUsage usage) const = 0;
+		virtual void AppendFile(std::filesystem::path path, const void* begin, const void* end, PathUsage usage) const = 0;
 
 		virtual mh::generator<std::filesystem::directory_entry> IterateDir(std::filesystem::path path, bool recursive,
 			std::filesystem::directory_options options = std::filesystem::directory_options::none) const = 0;
@@ -49,6 +50,10 @@ namespace tf2_bot_detector
 		{
 			return WriteFile(path, data.data(), data.data() + data.size(), usage);
 		}
+		void AppendFile(const std::filesystem::path& path, const std::string_view& data, PathUsage usage) const
+		{
+			return AppendFile(path, data.data(), data.data() + data.size(), usage);
+		}
 
 		static std::filesystem::path GetLogsDir(const std::filesystem::path& baseDataDir)
 		{
@@ -79,12 +79,34 @@ duration_t Player::GetConnectedTime() const
 	return result;
 }
 
+template<typename TInfo>
+static DB::ITempDB::CacheState TryGetCached(TInfo& info) try
+{
+	return TF2BDApplication::GetApplication().GetTempDB().TryGetCached(info);
+}
+catch (...)
+{
+	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to read {} from the temp DB", info.GetSteamID());
+	return DB::ITempDB::CacheState::Missing;
+}
+
+// Anything cached is shown right away, even if it has expired. Expired or missing data is
+// fetched again in the background, and replaces the cached copy when it arrives.
 const mh::expected<SteamAPI::PlayerSummary>& Player::GetPlayerSummary() const
 {
 	if (!m_PlayerSummary && m_PlayerSummary.error() == ErrorCode::LazyValueUninitialized)
 	{
-		m_PlayerSummary = std::errc::operation_in_progress;
-		m_World->QueuePlayerSummaryUpdate(GetSteamID());
+		DB::PlayerSummaryCacheInfo cacheInfo{};
+		cacheInfo.m_SteamID = GetSteamID();
+
+		const auto state = TryGetCached(cacheInfo);
+		if (state == DB::ITempDB::CacheState::Missing)
+			m_PlayerSummary = std::errc::operation_in_progress;
+		else
+			m_PlayerSummary = std::move(static_cast<SteamAPI::PlayerSummary&>(cacheInfo));
+
+		if (state != DB::ITempDB::CacheState::Fresh)
+			m_World->QueuePlayerSummaryUpdate(GetSteamID());
 	}
 
 	return m_PlayerSummary;
@@ -94,8 +116,17 @@ const mh::expected<SteamAPI::PlayerBans>& Player::GetPlayerBans() const
 {
 	if (!m_PlayerSteamBans && m_PlayerSteamBans.error() == ErrorCode::LazyValueUninitialized)
 	{
-		m_PlayerSteamBans = std::errc::operation_in_progress;
-		m_World->QueuePlayerBansUpdate(GetSteamID());
+		DB::PlayerBansCacheInfo cacheInfo{};
+		cacheInfo.m_SteamID = GetSteamID();
+
+		const auto state = TryGetCached(cacheInfo);
+		if (state == DB::ITempDB::CacheState::Missing)
+			m_PlayerSteamBans = std::errc::operation_in_progress;
+		else
+			m_PlayerSteamBans = std::move(static_cast<SteamAPI::PlayerBans&>(cacheInfo));
+
+		if (state != DB::ITempDB::CacheState::Fresh)
+			m_World->QueuePlayerBansUpdate(GetSteamID());
 	}
 
 	return m_PlayerSteamBans;
@@ -105,14 +136,42 @@ const mh::expected<SteamHistoryAPI::PlayerSourceBanState>& Player::GetPlayerSour
 {
 	if (!m_PlayerSourceBanState && m_PlayerSourceBanState.error() == ErrorCode::LazyValueUninitialized)
 	{
-		m_PlayerSourceBanState = std::errc::operation_in_progress;
-		m_PlayerSourceBans = std::errc::operation_in_progress;
-		m_World->QueuePlayerSourceBansUpdate(GetSteamID());
+		DB::PlayerSourceBansCacheInfo cacheInfo{};
+		cacheInfo.m_SteamID = GetSteamID();
+
+		const auto state = TryGetCached(cacheInfo);
+		if (state == DB::ITempDB::CacheState::Missing)
+		{
+			m_PlayerSourceBanState = std::errc::operation_in_progress;
+			m_PlayerSourceBans = std::errc::operation_in_progress;
+		}
+		else
+		{
+			m_PlayerSourceBanState = SteamHistoryAPI::GetLatestBanPerServer(cacheInfo.m_SourceBans);
+			m_PlayerSourceBans = std::move(cacheInfo.m_SourceBans);
+		}
+
+		if (state != DB::ITempDB::CacheState::Fresh)
+			m_World->QueuePlayerSourceBansUpdate(GetSteamID());
 	}
 
 	return m_PlayerSourceBanState;
 }
 
+// Once a player has left, requests about them that are still waiting on the rate limit aren't worth sending
+static HTTPRequestOptions GetPlayerRequestOptions(const std::shared_ptr<const Player>& player, HTTPRequestPriority priority)
+{
+	return HTTPRequestOptions
+	{
+		.m_Priority = priority,
+		.m_IsCancelled = [weakPlayer = std::weak_ptr<const Player>(player)]
+		{
+			auto player = weakPlayer.lock();
+			return !player || (!player->GetLobbyMember() && player->GetTimeSinceLastStatusUpdate() > 20s);
+		},
+	};
+}
+
 template<typename T, typename TFunc>
 const mh::expected<T>& Player::GetOrFetchDataAsync(mh::expected<T>& var, TFunc&& updateFunc,
 	std::initializer_list<std::error_condition> silentErrors, const mh::source_location& location) const
@@ -122,56 +181,76 @@ const mh::expected<T>& Player::GetOrFetchDataAsync(mh::expected<T>& var, TFunc&&
 	if (var == ErrorCode::LazyValueUninitialized ||
 		var == ErrorCode::InternetConnectivityDisabled)
 	{
-		auto client = m_World->GetSettings().GetHTTPClient();
+		FetchDataAsync(var, std::forward<TFunc>(updateFunc), silentErrors, location);
+	}
 
-		if (!client)
-		{
+	return var;
+}
+
+template<typename T, typename TFunc>
+void Player::FetchDataAsync(mh::expected<T>& var, TFunc&& updateFunc,
+	std::initializer_list<std::error_condition> silentErrors, const mh::source_location& location) const
+{
+	auto client = m_World->GetSettings().GetHTTPClient();
+
+	// If var already holds something (from the cache), keep showing it while this runs
+	if (!client)
+	{
+		if (!var)
 			var = ErrorCode::InternetConnectivityDisabled;
-		}
-		else
-		{
+	}
+	else
+	{
+		if (!var)
 			var = std::errc::operation_in_progress;
 
-			auto sharedThis = shared_from_this();
+		auto sharedThis = shared_from_this();
 
-			[](std::shared_ptr<const Player> sharedThis, std::shared_ptr<const IHTTPClient> client,
-				mh::expected<T>& var, std::vector<std::error_condition> silentErrors, TFunc updateFunc,
-				mh::source_location location) -> mh::task<>
+		[](std::shared_ptr<const Player> sharedThis, std::shared_ptr<const IHTTPClient> client,
+			mh::expected<T>& var, std::vector<std::error_condition> silentErrors, TFunc updateFunc,
+			mh::source_location location) -> mh::task<>
+		{
+			try
 			{
+				mh::expected<T> result;
 				try
 				{
-					mh::expected<T> result;
-					try
+					result = co_await updateFunc(sharedThis, client);
+				}
+				catch (const std::system_error& e)
+				{
+					if (e.code() == std::errc::operation_canceled)
 					{
-						result = co_await updateFunc(sharedThis, client);
+						// They left before it was sent, fetch it again if they come back
+						result = ErrorCode::LazyValueUninitialized;
 					}
-					catch (const std::system_error& e)
+					else
 					{
 						result = e.code().default_error_condition();
 
 						if (!mh::contains(silentErrors, result.error()))
 							DebugLogException(location, e);
 					}
-					catch (...)
-					{
-						LogException(location);
-						result = ErrorCode::UnknownError;
-					}
-
-					co_await GetDispatcher().co_dispatch();  // switch to main thread
-
-					var = std::move(result);
 				}
 				catch (...)
 				{
 					LogException(location);
+					result = ErrorCode::UnknownError;
 				}
 
-			}(sharedThis, client, var, silentErrors, std::move(updateFunc), location);
-		}
-	}
+				co_await GetDispatcher().co_dispatch();  // switch to main thread
 
-	return var;
+				// A failed refresh keeps whatever was already there
+				if (result || !var)
+					var = std::move(result);
+			}
+			catch (...)
+			{
+				LogException(location);
+			}
+
+		}(sharedThis, client, var, silentErrors, std::move(updateFunc), location);
+	}
 }
 
 const mh::expected<LogsTFAPI::PlayerLogsInfo>& Player::GetLogsInfo() const
@@ -184,9 +263,10 @@ const mh::expected<LogsTFAPI::PlayerLogsInfo>& Player::GetLogsInfo() const
 			DB::LogsTFCacheInfo cacheInfo{};
 			cacheInfo.m_ID = pThis->GetSteamID();
 
-			co_await cacheDB.GetOrUpdateAsync(cacheInfo, [&client](DB::LogsTFCacheInfo& info) -> mh::task<>
+			co_await cacheDB.GetOrUpdateAsync(cacheInfo, [&pThis, &client](DB::LogsTFCacheInfo& info) -> mh::task<>
 				{
-					info = co_await LogsTFAPI::GetPlayerLogsInfoAsync(client, info.m_ID);
+					info = co_await LogsTFAPI::GetPlayerLogsInfoAsync(client, info.m_ID,
+						GetPlayerRequestOptions(pThis, HTTPRequestPriority::Background));
 				});
 
 			co_return cacheInfo;
@@ -205,7 +285,8 @@ const mh::expected<SteamAPI::PlayerFriends>& Player::GetFriendsInfo() const
 
 			SteamAPI::PlayerFriends data;
 
-			data.m_Friends = co_await SteamAPI::GetFriendList(settings, pThis->GetSteamID(), *client);
+			data.m_Friends = co_await SteamAPI::GetFriendList(settings, pThis->GetSteamID(), *client,
+				GetPlayerRequestOptions(pThis, HTTPRequestPriority::Normal));
 
 			co_return data;
 		});
@@ -226,9 +307,10 @@ const mh::expected<SteamAPI::PlayerInventoryInfo>& Player::GetInventoryInfo() co
 			if (!settings.IsSteamAPIAvailable())
 				co_return SteamAPI::ErrorCode::SteamAPIDisabled;
 
-			co_await cacheDB.GetOrUpdateAsync(cacheInfo, [&settings, &client](DB::AccountInventorySizeInfo& info) -> mh::task<>
+			co_await cacheDB.GetOrUpdateAsync(cacheInfo, [&pThis, &settings, &client](DB::AccountInventorySizeInfo& info) -> mh::task<>
 				{
-					info = co_await SteamAPI::GetTF2InventoryInfoAsync(settings, info.GetSteamID(), *client);
+					info = co_await SteamAPI::GetTF2InventoryInfoAsync(settings, info.GetSteamID(), *client,
+						GetPlayerRequestOptions(pThis, HTTPRequestPriority::Background));
 				});
 
 			co_return cacheInfo;
@@ -239,15 +321,46 @@ mh::expected<duration_t> Player::GetTF2Playtime() const
 {
 	using ErrorCode = SteamAPI::ErrorCode;
 
-	return GetOrFetchDataAsync(m_TF2Playtime,
-		[&](std::shared_ptr<const Player> pThis, std::shared_ptr<const IHTTPClient> client) -> mh::task<mh::expected<duration_t>>
+	auto fetch = [](std::shared_ptr<const Player> pThis, std::shared_ptr<const IHTTPClient> client) -> mh::task<mh::expected<duration_t>>
+	{
+		const auto& settings = pThis->GetWorld().GetSettings();
+		if (!settings.IsSteamAPIAvailable())
+			co_return ErrorCode::SteamAPIDisabled;
+
+		const duration_t playtime = co_await SteamAPI::GetTF2PlaytimeAsync(settings, pThis->GetSteamID(), *client);
+
+		try
 		{
-			const auto& settings = pThis->GetWorld().GetSettings();
-			if (!settings.IsSteamAPIAvailable())
-				co_return ErrorCode::SteamAPIDisabled;
+			DB::TF2PlaytimeCacheInfo cacheInfo{};
+			cacheInfo.m_SteamID = pThis->GetSteamID();
+			cacheInfo.m_Playtime = playtime;
+			cacheInfo.m_LastCacheUpdateTime = tfbd_clock_t::now();
+			TF2BDApplication::GetApplication().GetTempDB().Store(cacheInfo);
+		}
+		catch (...)
+		{
+			// Store() already logged it, and the playtime itself is still good
+		}
+
+		co_return playtime;
+	};
+
+	if (m_TF2Playtime == ErrorCode::LazyValueUninitialized)
+	{
+		DB::TF2PlaytimeCacheInfo cacheInfo{};
+		cacheInfo.m_SteamID = GetSteamID();
+
+		if (const auto state = TryGetCached(cacheInfo); state != DB::ITempDB::CacheState::Missing)
+		{
+			m_TF2Playtime = cacheInfo.m_Playtime;
+			if (state == DB::ITempDB::CacheState::Expired)
+				FetchDataAsync(m_TF2Playtime, std::move(fetch), { ErrorCode::InfoPrivate, ErrorCode::GameNotOwned });
+
+			return m_TF2Playtime;
+		}
+	}
 
-			co_return co_await SteamAPI::GetTF2PlaytimeAsync(settings, GetSteamID(), *client);
-		}, { ErrorCode::InfoPrivate, ErrorCode::GameNotOwned });
+	return GetOrFetchDataAsync(m_TF2Playtime, std::move(fetch), { ErrorCode::InfoPrivate, ErrorCode::GameNotOwned });
 }
 
 bool Player::IsFriend() const
@@ -80,6 +80,9 @@ namespace tf2_bot_detector
 		template<typename T, typename TFunc>
 		const mh::expected<T>& GetOrFetchDataAsync(mh::expected<T>& variable, TFunc&& updateFunc,
 			std::initializer_list<std::error_condition> silentErrors = {}, MH_SOURCE_LOCATION_AUTO(location)) const;
+		template<typename T, typename TFunc>
+		void FetchDataAsync(mh::expected<T>& variable, TFunc&& updateFunc,
+			std::initializer_list<std::error_condition> silentErrors = {}, MH_SOURCE_LOCATION_AUTO(location)) const;
 
 		WorldState* m_World = nullptr;
 		PlayerStatus m_Status{};
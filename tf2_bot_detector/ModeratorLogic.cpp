@@ -91,7 +91,7 @@ namespace
 
 		struct PlayerExtraData
 		{
-			bool m_FriendsProcessed = false;
+			std::optional<uint64_t> m_MarkedFriendsVersion; // PlayerListJSON::GetMarksVersion() when last counted
 			MarkedFriends m_MarkedFriends;
 
 			// If this is a known cheater, warn them ahead of time that the player is connecting, but only once
@@ -285,13 +285,9 @@ void ModeratorLogic::OnPlayerStatusUpdate(IWorldState& world, const IPlayer& pla
 
 	if (m_Settings->m_AutoMark)
 	{
-		for (const ModerationRule& rule : m_Rules.GetRules())
-		{
-			if (!rule.Match(player))
-				continue;
-
-			OnRuleMatch(rule, player, rule.m_Description);
-		}
+		const auto rules = m_Rules.GetCompiledRules();
+		for (const CompiledModerationRule* rule : rules->FindMatches(player))
+			OnRuleMatch(rule->GetRule(), player, rule->GetRule().m_Description);
 	}
 }
 
@@ -339,11 +335,10 @@ void ModeratorLogic::OnChatMsg(IWorldState& world, IPlayer& player, const std::s
 
 	if (m_Settings->m_AutoMark && !botMsgDetected)
 	{
-		for (const ModerationRule& rule : m_Rules.GetRules())
+		const auto rules = m_Rules.GetCompiledRules();
+		for (const CompiledModerationRule* compiledRule : rules->FindMatches(player, msg))
 		{
-			if (!rule.Match(player, msg))
-				continue;
-
+			const ModerationRule& rule = compiledRule->GetRule();
 			std::string reason = rule.m_Description;
 
 			// why must i do this this feels dumb
@@ -356,7 +351,7 @@ void ModeratorLogic::OnChatMsg(IWorldState& world, IPlayer& player, const std::s
 			// so it doesn't actually append a chat message to reason when it's an avatar match for example
 			// the proper fix would be changing how rule.Match works and the return data
 			// but I actually cannot be arsed do to so gg
-			if (rule.Match(msg)) {
+			if (compiledRule->Match(msg)) {
 				reason = os.str();
 			}
 
@@ -1174,11 +1169,14 @@ void ModeratorLogic::SetUserRunningTool(const SteamID& id, bool isRunningTool)
 MarkedFriends ModeratorLogic::GetMarkedFriendsCount(IPlayer& player) const
 {
 	auto& data = player.GetOrCreateData<PlayerExtraData>();
-	if (data.m_FriendsProcessed) {
+
+	// Recount whenever anyone gets marked or unmarked, instead of latching the first result
+	const uint64_t marksVersion = m_PlayerList.GetMarksVersion();
+	if (data.m_MarkedFriendsVersion == marksVersion) {
 		return data.m_MarkedFriends;
 	}
 
-	auto friendsInfo = player.GetFriendsInfo();
+	const auto& friendsInfo = player.GetFriendsInfo();
 
 	// steamapi didn't get friends data yet; exit the function and this function will run again next loop.
 	if (!friendsInfo.has_value()) {
@@ -1186,39 +1184,15 @@ MarkedFriends ModeratorLogic::GetMarkedFriendsCount(IPlayer& player) const
 		return data.m_MarkedFriends;
 	}
 
-	uint32_t totalCount = 0;
-	uint32_t cheaterCount = 0;
-	uint32_t suspiciousCount = 0;
-	uint32_t exploiterCount = 0;
-	uint32_t racistCount = 0;
-
-	for (const SteamID& id : friendsInfo.value().m_Friends) {
-		auto playerAttributes = GetPlayerAttributes(id);
-
-		if (!playerAttributes.empty())
-		{
-			// TODO: dont do this ig
-			if (playerAttributes.Has(PlayerAttribute::Cheater))
-				cheaterCount++;
-			if (playerAttributes.Has(PlayerAttribute::Suspicious))
-				suspiciousCount++;
-			if (playerAttributes.Has(PlayerAttribute::Exploiter))
-				exploiterCount++;
-			if (playerAttributes.Has(PlayerAttribute::Racist))
-				racistCount++;
-
-			totalCount++;
-		}
-	}
+	const MarkedPlayerCounts counts = m_PlayerList.CountMarkedPlayers(friendsInfo.value().m_Friends);
 
 	data.m_MarkedFriends.m_FriendsCountTotal = static_cast<uint32_t>(friendsInfo.value().m_Friends.size());
 
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Cheater, cheaterCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Suspicious, suspiciousCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Exploiter, exploiterCount));
-	data.m_MarkedFriends.m_MarkedFriendsCount.insert(std::pair<PlayerAttribute, uint32_t>(PlayerAttribute::Racist, racistCount));
-	data.m_MarkedFriends.m_MarkedFriendsCountTotal = totalCount;
-	data.m_FriendsProcessed = true;
+	for (auto attribute : { PlayerAttribute::Cheater, PlayerAttribute::Suspicious, PlayerAttribute::Exploiter, PlayerAttribute::Racist })
+		data.m_MarkedFriends.m_MarkedFriendsCount[attribute] = counts.GetCount(attribute);
+
+	data.m_MarkedFriends.m_MarkedFriendsCountTotal = counts.m_MarkedCount;
+	data.m_MarkedFriendsVersion = marksVersion;
 
 	return data.m_MarkedFriends;
 }
@@ -17,28 +17,226 @@
 #endif
 #pragma warning(pop)
 
+#include <algorithm>
+#include <charconv>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <thread>
+
 using namespace std::chrono_literals;
 using namespace std::string_literals;
 using namespace tf2_bot_detector;
 
 namespace
 {
+	/// <summary>
+	/// The options of everyone waiting on the same request. It goes out at the highest priority
+	/// any of them asked for, and is only cancelled once all of them have been.
+	/// </summary>
+	class SharedRequestOptions final
+	{
+	public:
+		explicit SharedRequestOptions(HTTPRequestOptions options) { Add(std::move(options)); }
+
+		void Add(HTTPRequestOptions options);
+
+		HTTPRequestPriority GetPriority() const;
+		bool IsCancelled() const;
+
+	private:
+		mutable std::mutex m_Mutex;
+		HTTPRequestPriority m_Priority = HTTPRequestPriority::Background;
+		std::vector<std::function<bool()>> m_IsCancelled;
+		bool m_Cancellable = true; // Until someone joins without a way to cancel
+	};
+
+	/// <summary>
+	/// A token bucket per host, shared by every client since the rate limits belong to the servers.
+	/// Requests that have to wait for a token queue up by priority, and a HTTP 429 slows the
+	/// host down until it stops complaining.
+	/// </summary>
+	class RequestScheduler final
+	{
+	public:
+		static RequestScheduler& Get();
+
+		/// <summary>
+		/// Completes once the request is allowed to go out. Its place in line follows the options'
+		/// priority, even if that is raised while waiting.
+		/// Throws std::errc::operation_canceled if it was cancelled while waiting.
+		/// </summary>
+		mh::task<> AcquireAsync(const URL& url, const SharedRequestOptions& options);
+
+		void OnSuccess(const URL& url);
+		void OnTooManyRequests(const URL& url, std::optional<std::chrono::seconds> retryAfter);
+
+		std::vector<IHTTPClient::HostRequestCounts> GetHostCounts() const;
+
+	private:
+		using clock_type = mh::thread_pool::clock_t;
+		using duration_type = clock_type::duration;
+
+		static constexpr duration_type MAX_INTERVAL = 60s;
+
+		struct Limits
+		{
+			std::string m_Key;
+			duration_type m_Interval{}; // Zero means unlimited
+			double m_Burst = 1;
+		};
+		static Limits GetLimits(const URL& url);
+
+		struct Waiter
+		{
+			HTTPRequestPriority m_Priority;
+			uint64_t m_Sequence;
+		};
+
+		struct Bucket
+		{
+			duration_type m_BaseInterval{};
+			duration_type m_Interval{};
+			double m_Burst = 1;
+			double m_Tokens = 0;
+			clock_type::time_point m_LastRefill{}; // In the future while backing off after HTTP 429
+			std::vector<Waiter> m_Waiters;         // Next in line first
+			duration_type m_AverageWait{};
+		};
+
+		Bucket& GetBucket(const Limits& limits, clock_type::time_point now);
+		static void Refill(Bucket& bucket, clock_type::time_point now);
+		static std::vector<Waiter>::iterator InsertWaiter(Bucket& bucket, const Waiter& waiter);
+		static clock_type::time_point GetWakeTime(const Bucket& bucket, size_t position,
+			HTTPRequestPriority priority, clock_type::time_point now);
+		static void OnAcquired(Bucket& bucket, duration_type waitTime);
+
+		mutable std::mutex m_Mutex;
+		std::map<std::string, Bucket> m_Buckets;
+		uint64_t m_NextSequence = 0;
+	};
+
 	class HTTPClientImpl final : public IHTTPClient
 	{
 	public:
+		HTTPClientImpl(const HTTPClientConfig& config) : m_Config(config) {}
+
 		std::string GetString(const URL& url) const override;
-		mh::task<std::string> GetStringAsync(URL url) const override;
+		mh::task<std::string> GetStringAsync(URL url, HTTPRequestOptions options = {}) const override;
+		mh::task<ConditionalResponse> GetStringIfModifiedAsync(URL url, CacheValidators validators,
+			HTTPRequestOptions options = {}) const override;
 
 		RequestCounts GetRequestCounts() const override;
 
 	private:
+		const HTTPClientConfig m_Config;
+
+		mh::task<ConditionalResponse> SendAsync(URL url, CacheValidators validators,
+			std::shared_ptr<const SharedRequestOptions> options) const;
+
+		/// <summary>
+		/// One cpprest client per scheme/host/port. It keeps its connections alive between requests,
+		/// and only opens another one when requests overlap, so capping the requests running at once
+		/// caps the connections, and keeps requests reusing ones that are already warm.
+		/// </summary>
+		class HostConnections final
+		{
+		public:
+			HostConnections(const std::string& schemeHostPort, const HTTPClientConfig& config);
+
+			/// <summary>
+			/// Waits for a free connection. Every successful co_await must be paired with a Release().
+			/// </summary>
+			mh::task<> AcquireAsync();
+			void Release();
+
+			bool IsIdleFor(mh::thread_pool::clock_t::duration duration) const;
+
+			web::http::client::http_client& GetClient() { return m_Client; }
+
+		private:
+			struct Acquirer
+			{
+				HostConnections& m_Host;
+				bool m_Waited = false;
+
+				bool await_ready() const noexcept { return false; }
+				bool await_suspend(std::coroutine_handle<> handle) { return m_Waited = m_Host.TryWait(handle); }
+				bool await_resume() const noexcept { return m_Waited; }
+			};
+
+			bool TryWait(std::coroutine_handle<> handle);
+
+			web::http::client::http_client m_Client;
+			const uint32_t m_MaxConnections;
+
+			mutable std::mutex m_Mutex;
+			uint32_t m_ActiveRequests = 0;
+			std::deque<std::coroutine_handle<>> m_Waiters;
+			mh::thread_pool::clock_t::time_point m_LastUsed = mh::thread_pool::clock_t::now();
+		};
+
+		class ConnectionLease final
+		{
+		public:
+			explicit ConnectionLease(std::shared_ptr<HostConnections> host) : m_Host(std::move(host)) {}
+			ConnectionLease(const ConnectionLease&) = delete;
+			ConnectionLease& operator=(const ConnectionLease&) = delete;
+			~ConnectionLease() { m_Host->Release(); }
+
+			web::http::client::http_client& GetClient() const { return m_Host->GetClient(); }
+
+		private:
+			std::shared_ptr<HostConnections> m_Host;
+		};
+
 		mutable std::mutex m_InnerClientMutex;
-		mutable std::map<std::string, std::shared_ptr<web::http::client::http_client>> m_InnerClients;
-		std::shared_ptr<web::http::client::http_client> GetInnerClient(const URL& url) const;
+		mutable std::map<std::string, std::shared_ptr<HostConnections>> m_InnerClients;
+		std::shared_ptr<HostConnections> GetHostConnections(const URL& url) const;
 
 		mutable std::atomic_uint32_t m_TotalRequestCount = 0;
 		mutable std::atomic_uint32_t m_FailedRequestCount = 0;
 
+		/// <summary>
+		/// A GET that other callers asking for the same URL can wait on, instead of sending their own.
+		/// </summary>
+		class InFlightRequest final
+		{
+		public:
+			explicit InFlightRequest(HTTPRequestOptions options) :
+				m_Options(std::make_shared<SharedRequestOptions>(std::move(options)))
+			{
+			}
+
+			const std::shared_ptr<SharedRequestOptions> m_Options;
+
+			void Complete(const std::string& body, std::exception_ptr error);
+
+			bool await_ready() const noexcept { return false; }
+			bool await_suspend(std::coroutine_handle<> handle);
+			std::string await_resume() const;
+
+		private:
+			std::mutex m_Mutex;
+			bool m_Done = false;
+			std::string m_Body;
+			std::exception_ptr m_Error;
+			std::vector<std::coroutine_handle<>> m_Waiters;
+		};
+
+		struct CachedResponse
+		{
+			std::string m_Body;
+			mh::thread_pool::clock_t::time_point m_Expiration;
+		};
+
+		mutable std::mutex m_ResponseCacheMutex;
+		mutable std::map<std::string, std::shared_ptr<InFlightRequest>> m_InFlightRequests;
+		mutable std::map<std::string, CachedResponse> m_CachedResponses;
+		mutable std::atomic_uint32_t m_CacheHitCount = 0;
+		mutable std::atomic_uint32_t m_CacheMissCount = 0;
+		mutable std::atomic_uint32_t m_CoalescedRequestCount = 0;
+
 		// This is a pretty stupid way of implementing this lol, but its easy
 		struct RequestInProgressObj {};
 		struct RequestQueuedObj {};
@@ -47,6 +245,242 @@ namespace
 	};
 }
 
+void SharedRequestOptions::Add(HTTPRequestOptions options)
+{
+	std::lock_guard lock(m_Mutex);
+	m_Priority = std::max(m_Priority, options.m_Priority);
+
+	if (!options.m_IsCancelled)
+	{
+		m_Cancellable = false;
+		m_IsCancelled.clear();
+	}
+	else if (m_Cancellable)
+	{
+		m_IsCancelled.push_back(std::move(options.m_IsCancelled));
+	}
+}
+
+HTTPRequestPriority SharedRequestOptions::GetPriority() const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_Priority;
+}
+
+bool SharedRequestOptions::IsCancelled() const
+{
+	std::vector<std::function<bool()>> isCancelled;
+	{
+		std::lock_guard lock(m_Mutex);
+		if (!m_Cancellable)
+			return false;
+
+		isCancelled = m_IsCancelled;
+	}
+
+	// Not under the lock, these belong to the callers
+	return std::all_of(isCancelled.begin(), isCancelled.end(), [](const auto& func) { return func(); });
+}
+
+RequestScheduler& RequestScheduler::Get()
+{
+	static RequestScheduler s_RequestScheduler;
+	return s_RequestScheduler;
+}
+
+auto RequestScheduler::GetLimits(const URL& url) -> Limits
+{
+	if (url.m_Host.ends_with("akamaihd.net") ||
+		url.m_Host.ends_with("steamstatic.com"))
+	{
+		return { url.m_Host, 0ms };
+	}
+	else if (url.m_Host == "api.steampowered.com")
+	{
+		if (mh::case_insensitive_view(url.m_Path).find("/GetPlayerItems/") != url.m_Path.npos)
+			return { url.m_Host + "/GetPlayerItems", 1000ms, 1 }; // This is a slow/heavily throttled api
+
+		return { url.m_Host, 100ms, 4 };
+	}
+	else if (url.m_Host == "steamcommunity.com")
+	{
+		return { url.m_Host, 2000ms, 1 };
+	}
+
+	return { url.m_Host, 500ms, 2 };
+}
+
+auto RequestScheduler::GetBucket(const Limits& limits, clock_type::time_point now) -> Bucket&
+{
+	auto [it, inserted] = m_Buckets.try_emplace(limits.m_Key);
+	if (inserted)
+	{
+		Bucket& bucket = it->second;
+		bucket.m_BaseInterval = bucket.m_Interval = limits.m_Interval;
+		bucket.m_Burst = bucket.m_Tokens = limits.m_Burst;
+		bucket.m_LastRefill = now;
+	}
+
+	return it->second;
+}
+
+void RequestScheduler::Refill(Bucket& bucket, clock_type::time_point now)
+{
+	if (now <= bucket.m_LastRefill)
+		return;
+
+	bucket.m_Tokens = std::min(bucket.m_Burst, bucket.m_Tokens + double((now - bucket.m_LastRefill).count()) / bucket.m_Interval.count());
+	bucket.m_LastRefill = now;
+}
+
+auto RequestScheduler::InsertWaiter(Bucket& bucket, const Waiter& waiter) -> std::vector<Waiter>::iterator
+{
+	const auto insertPos = std::find_if(bucket.m_Waiters.begin(), bucket.m_Waiters.end(),
+		[&](const Waiter& entry) { return entry.m_Priority < waiter.m_Priority; });
+	return bucket.m_Waiters.insert(insertPos, waiter);
+}
+
+auto RequestScheduler::GetWakeTime(const Bucket& bucket, size_t position, HTTPRequestPriority priority,
+	clock_type::time_point now) -> clock_type::time_point
+{
+	// Tokens that still have to show up before it's this waiter's turn
+	const double missingTokens = std::max(0.0, double(position + 1) - bucket.m_Tokens);
+	const auto wakeTime = std::max(now, bucket.m_LastRefill) + duration_type(duration_type::rep(bucket.m_Interval.count() * missingTokens));
+
+	// Someone more important could join the request while it waits, so check back every
+	// interval until nothing can outrank it
+	if (priority < HTTPRequestPriority::Interactive)
+		return std::min(wakeTime, now + bucket.m_Interval);
+
+	return wakeTime;
+}
+
+void RequestScheduler::OnAcquired(Bucket& bucket, duration_type waitTime)
+{
+	bucket.m_Tokens -= 1;
+	bucket.m_AverageWait = (bucket.m_AverageWait * 7 + waitTime) / 8;
+}
+
+mh::task<> RequestScheduler::AcquireAsync(const URL& url, const SharedRequestOptions& options)
+{
+	const Limits limits = GetLimits(url);
+	if (limits.m_Interval <= 0ms)
+		co_return;
+
+	const auto queuedTime = clock_type::now();
+	HTTPRequestPriority priority = options.GetPriority();
+	uint64_t sequence;
+	clock_type::time_point wakeTime;
+	{
+		std::lock_guard lock(m_Mutex);
+		Bucket& bucket = GetBucket(limits, queuedTime);
+		Refill(bucket, queuedTime);
+
+		if (bucket.m_Tokens >= 1 && (bucket.m_Waiters.empty() || bucket.m_Waiters.front().m_Priority < priority))
+		{
+			OnAcquired(bucket, {});
+			co_return;
+		}
+
+		sequence = ++m_NextSequence;
+		const auto waiter = InsertWaiter(bucket, Waiter{ priority, sequence });
+		wakeTime = GetWakeTime(bucket, size_t(waiter - bucket.m_Waiters.begin()), priority, queuedTime);
+	}
+
+	while (true)
+	{
+		co_await GetDispatcher().co_delay_until(wakeTime);
+
+		const bool cancelled = options.IsCancelled();
+		const HTTPRequestPriority newPriority = options.GetPriority();
+
+		std::lock_guard lock(m_Mutex);
+		Bucket& bucket = m_Buckets.at(limits.m_Key);
+		const auto now = clock_type::now();
+		auto waiter = std::find_if(bucket.m_Waiters.begin(), bucket.m_Waiters.end(),
+			[&](const Waiter& entry) { return entry.m_Sequence == sequence; });
+
+		if (cancelled)
+		{
+			bucket.m_Waiters.erase(waiter);
+			throw std::system_error(std::make_error_code(std::errc::operation_canceled));
+		}
+
+		if (newPriority > priority)
+		{
+			// Someone more important joined this request
+			priority = newPriority;
+			bucket.m_Waiters.erase(waiter);
+			waiter = InsertWaiter(bucket, Waiter{ priority, sequence });
+		}
+
+		Refill(bucket, now);
+		if (waiter == bucket.m_Waiters.begin() && bucket.m_Tokens >= 1)
+		{
+			bucket.m_Waiters.erase(waiter);
+			OnAcquired(bucket, now - queuedTime);
+			co_return;
+		}
+
+		// Something more important cut in line, or we're backing off
+		wakeTime = GetWakeTime(bucket, size_t(waiter - bucket.m_Waiters.begin()), priority, now);
+	}
+}
+
+void RequestScheduler::OnSuccess(const URL& url)
+{
+	const Limits limits = GetLimits(url);
+	if (limits.m_Interval <= 0ms)
+		return;
+
+	std::lock_guard lock(m_Mutex);
+	Bucket& bucket = GetBucket(limits, clock_type::now());
+
+	// Ease back towards the normal rate, a lot slower than we backed off
+	bucket.m_Interval = std::max(bucket.m_BaseInterval, bucket.m_Interval * 15 / 16);
+}
+
+void RequestScheduler::OnTooManyRequests(const URL& url, std::optional<std::chrono::seconds> retryAfter)
+{
+	const Limits limits = GetLimits(url);
+	if (limits.m_Interval <= 0ms)
+		return;
+
+	std::lock_guard lock(m_Mutex);
+	const auto now = clock_type::now();
+	Bucket& bucket = GetBucket(limits, now);
+
+	bucket.m_Interval = std::min(MAX_INTERVAL, bucket.m_Interval * 2);
+	bucket.m_Tokens = 0;
+
+	// Nothing refills until the host is willing to talk to us again
+	const duration_type pause = retryAfter ? std::chrono::duration_cast<duration_type>(*retryAfter) : bucket.m_Interval;
+	bucket.m_LastRefill = std::max(bucket.m_LastRefill, now + pause);
+}
+
+std::vector<IHTTPClient::HostRequestCounts> RequestScheduler::GetHostCounts() const
+{
+	using std::chrono::duration_cast;
+	using std::chrono::milliseconds;
+
+	std::lock_guard lock(m_Mutex);
+
+	std::vector<IHTTPClient::HostRequestCounts> retVal;
+	retVal.reserve(m_Buckets.size());
+	for (const auto& [key, bucket] : m_Buckets)
+	{
+		retVal.push_back(IHTTPClient::HostRequestCounts
+			{
+				.m_Host = key,
+				.m_Queued = static_cast<uint32_t>(bucket.m_Waiters.size()),
+				.m_AverageWait = duration_cast<milliseconds>(bucket.m_AverageWait),
+				.m_Interval = duration_cast<milliseconds>(bucket.m_Interval),
+			});
+	}
+
+	return retVal;
+}
+
 std::string HTTPClientImpl::GetString(const URL& url) const
 {
 	auto task = GetStringAsync(url);
@@ -54,10 +488,83 @@ std::string HTTPClientImpl::GetString(const URL& url) const
 	return std::move(task.get());
 }
 
-std::shared_ptr<web::http::client::http_client> HTTPClientImpl::GetInnerClient(const URL& url) const
+static web::http::client::http_client_config MakeInnerClientConfig(const HTTPClientConfig& config)
+{
+	web::http::client::http_client_config retVal;
+	retVal.set_timeout(config.m_RequestTimeout);
+	return retVal;
+}
+
+HTTPClientImpl::HostConnections::HostConnections(const std::string& schemeHostPort, const HTTPClientConfig& config) :
+	m_Client(utility::conversions::to_string_t(schemeHostPort), MakeInnerClientConfig(config)),
+	m_MaxConnections(std::max<uint32_t>(config.m_MaxConnectionsPerHost, 1))
+{
+}
+
+// Requests that had to wait for a connection carry on here, rather than inside whichever
+// request released it
+static mh::thread_pool& GetConnectionHandoffPool()
+{
+	static mh::thread_pool s_Pool(std::max(std::thread::hardware_concurrency(), 2u));
+	return s_Pool;
+}
+
+mh::task<> HTTPClientImpl::HostConnections::AcquireAsync()
+{
+	// Release() resumes us on its own thread, in the middle of tearing down the previous request.
+	// Only stay there long enough to get onto the pool, so requests don't nest inside each other.
+	if (co_await Acquirer{ *this })
+		co_await GetConnectionHandoffPool().co_add_task();
+}
+
+bool HTTPClientImpl::HostConnections::TryWait(std::coroutine_handle<> handle)
+{
+	std::lock_guard lock(m_Mutex);
+	if (m_ActiveRequests < m_MaxConnections)
+	{
+		m_ActiveRequests++;
+		return false;
+	}
+
+	m_Waiters.push_back(handle);
+	return true;
+}
+
+void HTTPClientImpl::HostConnections::Release()
+{
+	std::coroutine_handle<> next;
+	{
+		std::lock_guard lock(m_Mutex);
+		m_LastUsed = mh::thread_pool::clock_t::now();
+
+		if (m_Waiters.empty())
+		{
+			m_ActiveRequests--;
+			return;
+		}
+
+		// Hand our connection straight to the next request in line. It moves itself onto
+		// GetConnectionHandoffPool() as soon as it is resumed, so this returns right away.
+		next = m_Waiters.front();
+		m_Waiters.pop_front();
+	}
+
+	next.resume();
+}
+
+bool HTTPClientImpl::HostConnections::IsIdleFor(mh::thread_pool::clock_t::duration duration) const
+{
+	std::lock_guard lock(m_Mutex);
+	return m_ActiveRequests == 0 && (mh::thread_pool::clock_t::now() - m_LastUsed) > duration;
+}
+
+auto HTTPClientImpl::GetHostConnections(const URL& url) const -> std::shared_ptr<HostConnections>
 {
 	std::lock_guard lock(m_InnerClientMutex);
 
+	// Closes their kept-alive connections (once any requests still holding them finish)
+	std::erase_if(m_InnerClients, [&](const auto& entry) { return entry.second->IsIdleFor(m_Config.m_IdleTimeout); });
+
 	const std::string schemeHostPort = url.GetSchemeHostPort();
 	if (auto found = m_InnerClients.find(schemeHostPort); found != m_InnerClients.end())
 	{
@@ -65,34 +572,165 @@ std::shared_ptr<web::http::client::http_client> HTTPClientImpl::GetInnerClient(c
 	}
 	else
 	{
-		auto newClient = std::make_shared<web::http::client::http_client>(utility::conversions::to_string_t(schemeHostPort));
+		auto newClient = std::make_shared<HostConnections>(schemeHostPort, m_Config);
 		return m_InnerClients.emplace(schemeHostPort, newClient).first->second;
 	}
 }
 
-static duration_t GetMinRequestInterval(const URL& url)
+void HTTPClientImpl::InFlightRequest::Complete(const std::string& body, std::exception_ptr error)
+{
+	std::vector<std::coroutine_handle<>> waiters;
+	{
+		std::lock_guard lock(m_Mutex);
+		m_Done = true;
+		m_Body = body;
+		m_Error = std::move(error);
+		waiters.swap(m_Waiters);
+	}
+
+	for (auto waiter : waiters)
+		waiter.resume();
+}
+
+bool HTTPClientImpl::InFlightRequest::await_suspend(std::coroutine_handle<> handle)
+{
+	std::lock_guard lock(m_Mutex);
+	if (m_Done)
+		return false;
+
+	m_Waiters.push_back(handle);
+	return true;
+}
+
+std::string HTTPClientImpl::InFlightRequest::await_resume() const
+{
+	// Nothing changes once m_Done is set
+	if (m_Error)
+		std::rethrow_exception(m_Error);
+
+	return m_Body;
+}
+
+// How long a response can be handed out again without asking the server
+static mh::thread_pool::clock_t::duration GetResponseCacheTime(const URL& url)
 {
 	if (url.m_Host.ends_with("akamaihd.net") ||
 		url.m_Host.ends_with("steamstatic.com"))
 	{
-		return 0ms;
+		return 5min; // Avatars, the url changes along with the image
 	}
-	else if (url.m_Host == "api.steampowered.com")
+	else if (url.m_Host == "api.steampowered.com" || url.m_Host == "logs.tf")
 	{
-		if (mh::case_insensitive_view(url.m_Path).find("/GetPlayerItems/") != url.m_Path.npos)
-			return 1000ms; // This is a slow/heavily throttled api
+		return 1min; // Friend lists and playtimes asked for again by tooltips and rejoining players
+	}
+
+	return 0s;
+}
 
-		return 100ms;
+static std::string GetHeader(const web::http::http_headers& headers, const utility::string_t& name)
+{
+	if (auto found = headers.find(name); found != headers.end())
+		return utility::conversions::to_utf8string(found->second);
+
+	return {};
+}
+
+static std::optional<std::chrono::seconds> GetRetryAfter(const web::http::http_headers& headers)
+{
+	// Only the delay-seconds form, nobody sends the HTTP-date one to API clients
+	const std::string value = GetHeader(headers, _XPLATSTR("Retry-After"));
+
+	uint32_t seconds;
+	if (auto result = std::from_chars(value.data(), value.data() + value.size(), seconds);
+		result.ec != std::errc{} || result.ptr != value.data() + value.size())
+	{
+		return std::nullopt;
 	}
-	else if (url.m_Host == "steamcommunity.com")
+
+	return std::chrono::seconds(seconds);
+}
+
+mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url, HTTPRequestOptions options) const
+{
+	auto self = shared_from_this(); // Make sure we don't vanish
+	const std::string key = url.ToString();
+	const auto cacheTime = GetResponseCacheTime(url);
+
+	std::shared_ptr<InFlightRequest> inFlight;
+	std::shared_ptr<const SharedRequestOptions> sharedOptions;
 	{
-		return 2000ms;
+		std::lock_guard lock(m_ResponseCacheMutex);
+		if (auto found = m_CachedResponses.find(key); found != m_CachedResponses.end())
+		{
+			if (mh::thread_pool::clock_t::now() < found->second.m_Expiration)
+			{
+				m_CacheHitCount++;
+				co_return found->second.m_Body;
+			}
+
+			m_CachedResponses.erase(found);
+		}
+
+		if (auto found = m_InFlightRequests.find(key); found != m_InFlightRequests.end())
+		{
+			m_CoalescedRequestCount++;
+			inFlight = found->second;
+			inFlight->m_Options->Add(std::move(options));
+		}
+		else
+		{
+			m_CacheMissCount++;
+			auto newRequest = std::make_shared<InFlightRequest>(std::move(options));
+			sharedOptions = newRequest->m_Options;
+			m_InFlightRequests.emplace(key, std::move(newRequest));
+		}
 	}
 
-	return 500ms;
+	if (inFlight)
+		co_return co_await *inFlight;
+
+	// We're the one sending it, everyone else asking in the meantime gets our result
+	std::string body;
+	std::exception_ptr error;
+	try
+	{
+		auto response = co_await SendAsync(std::move(url), {}, std::move(sharedOptions));
+		body = std::move(response.m_Body);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	{
+		std::lock_guard lock(m_ResponseCacheMutex);
+		inFlight = std::move(m_InFlightRequests.at(key));
+		m_InFlightRequests.erase(key);
+
+		if (!error && cacheTime > 0s)
+		{
+			const auto now = mh::thread_pool::clock_t::now();
+			std::erase_if(m_CachedResponses, [&](const auto& entry) { return entry.second.m_Expiration <= now; });
+			m_CachedResponses.insert_or_assign(key, CachedResponse{ body, now + cacheTime });
+		}
+	}
+
+	inFlight->Complete(body, error);
+
+	if (error)
+		std::rethrow_exception(error);
+
+	co_return body;
 }
 
-mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
+mh::task<IHTTPClient::ConditionalResponse> HTTPClientImpl::GetStringIfModifiedAsync(URL url, CacheValidators validators,
+	HTTPRequestOptions options) const
+{
+	co_return co_await SendAsync(std::move(url), std::move(validators), std::make_shared<SharedRequestOptions>(std::move(options)));
+}
+
+mh::task<IHTTPClient::ConditionalResponse> HTTPClientImpl::SendAsync(URL url, CacheValidators validators,
+	std::shared_ptr<const SharedRequestOptions> options) const try
 {
 	auto self = shared_from_this(); // Make sure we don't vanish
 	std::shared_ptr<RequestInProgressObj> inProgressObj;
@@ -117,40 +755,10 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 	int32_t retryCount = 0;
 	while (true)
 	{
-		using throttle_time_t = mh::thread_pool::clock_t::time_point;
-		throttle_time_t throttleTime{};
-		{
-			const duration_t MIN_INTERVAL = GetMinRequestInterval(url);
-
-			static std::mutex s_ThrottleMutex;
-			static std::map<std::string, throttle_time_t> s_ThrottleDomains;
-			std::lock_guard lock(s_ThrottleMutex);
-
-			auto now = mh::thread_pool::clock_t::now();
-
-			if (auto found = s_ThrottleDomains.find(url.m_Host);
-				found != s_ThrottleDomains.end())
-			{
-				if (now > found->second)
-				{
-					found->second = now + MIN_INTERVAL;
-				}
-				else
-				{
-					throttleTime = found->second;
-					found->second += MIN_INTERVAL;
-				}
-			}
-			else
-			{
-				s_ThrottleDomains.emplace(url.m_Host, now + MIN_INTERVAL);
-			}
-		}
-
-		if (throttleTime != throttle_time_t{})
+		if (m_Config.m_RateLimited)
 		{
 			SetThrottled(true);
-			co_await GetDispatcher().co_delay_until(throttleTime);
+			co_await RequestScheduler::Get().AcquireAsync(url, *options);
 			SetThrottled(false);
 		}
 
@@ -161,20 +769,47 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 			{
 				auto requestIndex = ++m_TotalRequestCount;
 
-				auto client = GetInnerClient(url);
+				auto host = GetHostConnections(url);
+				SetThrottled(true);
+				co_await host->AcquireAsync();
+				SetThrottled(false);
+				const ConnectionLease connection(std::move(host));
 
 				const auto startTime = tfbd_clock_t::now();
 
+				web::http::http_request request(web::http::methods::GET);
+				request.set_request_uri(utility::conversions::to_string_t(url.m_Path));
+				if (!validators.m_ETag.empty())
+					request.headers().add(web::http::header_names::if_none_match, utility::conversions::to_string_t(validators.m_ETag));
+				if (!validators.m_LastModified.empty())
+					request.headers().add(web::http::header_names::if_modified_since, utility::conversions::to_string_t(validators.m_LastModified));
+
 #ifdef __linux__
 				// TODO: investiagte how bad this is, we don't have pplawait.h
-				auto response = client->request(web::http::methods::GET, utility::conversions::to_string_t(url.m_Path)).get();
+				auto response = connection.GetClient().request(request).get();
 #else
-				auto response = co_await client->request(web::http::methods::GET, utility::conversions::to_string_t(url.m_Path));
+				auto response = co_await connection.GetClient().request(request);
 #endif
 
+				if (response.status_code() == static_cast<web::http::status_code>(HTTPResponseCode::TooManyRequests))
+					RequestScheduler::Get().OnTooManyRequests(url, GetRetryAfter(response.headers()));
+				else
+					RequestScheduler::Get().OnSuccess(url);
+
 				if (response.status_code() >= 400 && response.status_code() < 600)
 					throw http_error((HTTPResponseCode)response.status_code(), mh::format("Failed to HTTP GET {}", url));
 
+				if (response.status_code() == web::http::status_codes::NotModified)
+				{
+					const auto duration = tfbd_clock_t::now() - startTime;
+					DebugLog("[{}ms] HTTP GET #{} (not modified): {}", std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(), requestIndex, url);
+
+					ConditionalResponse notModified;
+					notModified.m_NotModified = true;
+					notModified.m_Validators = std::move(validators);
+					co_return std::move(notModified);
+				}
+
 #ifdef __linux__
 				std::string stringResponse = response.extract_utf8string(true).get();
 #else
@@ -184,7 +819,11 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 				const auto duration = tfbd_clock_t::now() - startTime;
 				DebugLog("[{}ms] HTTP GET #{}: {}", std::chrono::duration_cast<std::chrono::milliseconds>(duration).count(), requestIndex, url);
 
-				co_return std::move(stringResponse);
+				ConditionalResponse retVal;
+				retVal.m_Body = std::move(stringResponse);
+				retVal.m_Validators.m_ETag = GetHeader(response.headers(), web::http::header_names::etag);
+				retVal.m_Validators.m_LastModified = GetHeader(response.headers(), web::http::header_names::last_modified);
+				co_return std::move(retVal);
 			}
 			catch (...)
 			{
@@ -203,6 +842,7 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 			{
 				// retry a fair number of times for http 429, some stuff is aggressively throttled
 				PrintRetryWarning();
+				retryDelayTime = 0s; // The scheduler has already backed off this host
 			}
 			else if (e.code() == HTTPResponseCode::InternalServerError && retryCount < 5)
 			{
@@ -229,6 +869,7 @@ mh::task<std::string> HTTPClientImpl::GetStringAsync(URL url) const try
 		}
 
 		// Wait and try again
+		if (retryDelayTime > 0s)
 		{
 			SetThrottled(true);
 			co_await GetDispatcher().co_delay_for(retryDelayTime);
@@ -243,6 +884,15 @@ catch (const http_error&)
 	DebugLogException("{}", url);
 	throw;
 }
+catch (const std::system_error& e)
+{
+	if (e.code() == std::errc::operation_canceled)
+		DebugLog("Cancelled HTTP GET: {}", url);
+	else
+		LogException("{}", url);
+
+	throw;
+}
 catch (...)
 {
 	LogException("{}", url);
@@ -257,10 +907,14 @@ auto HTTPClientImpl::GetRequestCounts() const -> RequestCounts
 		.m_Failed = m_FailedRequestCount,
 		.m_InProgress = static_cast<uint32_t>(m_InProgressRequestCount.use_count() - 1),
 		.m_Throttled = static_cast<uint32_t>(m_QueuedRequestCount.use_count() - 1),
+		.m_CacheHits = m_CacheHitCount,
+		.m_CacheMisses = m_CacheMissCount,
+		.m_Coalesced = m_CoalescedRequestCount,
+		.m_Hosts = RequestScheduler::Get().GetHostCounts(),
 	};
 }
 
-std::shared_ptr<IHTTPClient> tf2_bot_detector::IHTTPClient::Create()
+std::shared_ptr<IHTTPClient> tf2_bot_detector::IHTTPClient::Create(const HTTPClientConfig& config)
 {
-	return std::make_shared<HTTPClientImpl>();
+	return std::make_shared<HTTPClientImpl>(config);
 }
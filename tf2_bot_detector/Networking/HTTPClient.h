@@ -2,23 +2,102 @@
 
 #include <mh/coroutine/task.hpp>
 
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace tf2_bot_detector
 {
 	class URL;
 
+	/// <summary>
+	/// When several requests to the same host are waiting on its rate limit, higher priorities go first.
+	/// </summary>
+	enum class HTTPRequestPriority
+	{
+		Background,  // Nobody is looking at the result yet (inventories, logs.tf)
+		Normal,
+		Interactive, // Shown on the scoreboard as soon as it arrives
+	};
+
+	struct HTTPRequestOptions
+	{
+		HTTPRequestPriority m_Priority = HTTPRequestPriority::Normal;
+
+		/// <summary>
+		/// Checked on the main thread while the request is waiting on the rate limit. Once it returns
+		/// true, the request is dropped without being sent, failing with std::errc::operation_canceled.
+		/// A request shared with other callers (see GetStringAsync) is only dropped once all of them
+		/// are cancelled. Until then, it is sent at the highest priority any of them asked for.
+		/// </summary>
+		std::function<bool()> m_IsCancelled;
+	};
+
+	struct HTTPClientConfig
+	{
+		// Requests to a host beyond this wait for one of its connections to free up, rather than
+		// opening (and TLS handshaking) another one
+		uint32_t m_MaxConnectionsPerHost = 4;
+
+		// Connections to a host that hasn't been talked to for this long are closed
+		std::chrono::seconds m_IdleTimeout{ 90 };
+
+		std::chrono::seconds m_RequestTimeout{ 30 };
+
+		// Only turn this off for servers we run ourselves, like the loopback server in the tests.
+		// Everywhere else the limits belong to the host, and are shared by every client.
+		bool m_RateLimited = true;
+	};
+
 	// Only intended to be stored if you are doing something async
 	class IHTTPClient : public std::enable_shared_from_this<IHTTPClient>
 	{
 	public:
 		virtual ~IHTTPClient() = default;
 
-		static std::shared_ptr<IHTTPClient> Create();
+		static std::shared_ptr<IHTTPClient> Create(const HTTPClientConfig& config = {});
 
 		virtual std::string GetString(const URL& url) const = 0;
-		virtual mh::task<std::string> GetStringAsync(URL url) const = 0;
+		/// <summary>
+		/// Callers asking for a URL that is already being fetched share that request, and some
+		/// hosts' responses are kept around in memory for a little while afterwards.
+		/// </summary>
+		virtual mh::task<std::string> GetStringAsync(URL url, HTTPRequestOptions options = {}) const = 0;
+
+		/// <summary>
+		/// The ETag/Last-Modified headers of a response, sent back as If-None-Match/If-Modified-Since.
+		/// </summary>
+		struct CacheValidators
+		{
+			std::string m_ETag;
+			std::string m_LastModified;
+
+			bool empty() const { return m_ETag.empty() && m_LastModified.empty(); }
+		};
+
+		struct ConditionalResponse
+		{
+			bool m_NotModified = false;   // HTTP 304, m_Body is empty
+			std::string m_Body;
+			CacheValidators m_Validators; // Of the new response, or the ones we sent if not modified
+		};
+
+		/// <summary>
+		/// Like GetStringAsync, but lets the server reply 304 Not Modified instead of sending a body
+		/// we already have.
+		/// </summary>
+		virtual mh::task<ConditionalResponse> GetStringIfModifiedAsync(URL url, CacheValidators validators,
+			HTTPRequestOptions options = {}) const = 0;
+
+		struct HostRequestCounts
+		{
+			std::string m_Host;
+			uint32_t m_Queued;                      // Waiting on this host's rate limit
+			std::chrono::milliseconds m_AverageWait; // How long requests have recently waited for their turn
+			std::chrono::milliseconds m_Interval;    // Current time between requests, raised after HTTP 429
+		};
 
 		struct RequestCounts
 		{
@@ -26,6 +105,10 @@ namespace tf2_bot_detector
 			uint32_t m_Failed;
 			uint32_t m_InProgress;  // Waiting on the server
 			uint32_t m_Throttled;   // Locally throttled
+			uint32_t m_CacheHits;   // Answered from the in-memory response cache
+			uint32_t m_CacheMisses;
+			uint32_t m_Coalesced;   // Shared a request that was already in flight for the same URL
+			std::vector<HostRequestCounts> m_Hosts;
 		};
 
 		virtual RequestCounts GetRequestCounts() const = 0;
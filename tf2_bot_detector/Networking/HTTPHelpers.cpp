@@ -44,7 +44,7 @@ URL::URL(const std::string_view& url)
 
 	if (firstColon < firstSlash)
 	{
-		auto portStr = url.substr(firstColon, firstSlash);
+		auto portStr = url.substr(firstColon + 1, firstSlash - firstColon - 1);
 		if (!mh::from_chars(portStr, m_Port))
 			throw std::invalid_argument("Failed to parse port from "s << std::quoted(url));
 	}
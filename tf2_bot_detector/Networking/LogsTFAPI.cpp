@@ -6,9 +6,11 @@
 
 using namespace tf2_bot_detector;
 
-mh::task<LogsTFAPI::PlayerLogsInfo> LogsTFAPI::GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id)
+mh::task<LogsTFAPI::PlayerLogsInfo> LogsTFAPI::GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id,
+	HTTPRequestOptions options)
 {
-	const std::string string = co_await client->GetStringAsync(mh::format("https://logs.tf/api/v1/log?player={}&limit=0", id.ID64));
+	const std::string string = co_await client->GetStringAsync(
+		mh::format("https://logs.tf/api/v1/log?player={}&limit=0", id.ID64), std::move(options));
 
 	const nlohmann::json json = nlohmann::json::parse(string);
 
@@ -1,16 +1,12 @@
 #pragma once
 
+#include "HTTPClient.h"
 #include "SteamID.h"
 
 #include <mh/coroutine/task.hpp>
 
 #include <memory>
 
-namespace tf2_bot_detector
-{
-	class IHTTPClient;
-}
-
 namespace tf2_bot_detector::LogsTFAPI
 {
 	struct PlayerLogsInfo
@@ -19,5 +15,6 @@ namespace tf2_bot_detector::LogsTFAPI
 		uint32_t m_LogsCount;
 	};
 
-	mh::task<PlayerLogsInfo> GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id);
+	mh::task<PlayerLogsInfo> GetPlayerLogsInfoAsync(std::shared_ptr<const IHTTPClient> client, SteamID id,
+		HTTPRequestOptions options = {});
 }
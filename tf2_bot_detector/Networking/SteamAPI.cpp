@@ -208,7 +208,8 @@ std::string tf2_bot_detector::SteamAPI::GenerateSteamIDsQueryParam(const std::ve
 }
 
 mh::task<std::vector<PlayerSummary>> tf2_bot_detector::SteamAPI::GetPlayerSummariesAsync(
-	const ISteamAPISettings& apiSettings, const std::vector<SteamID>& steamIDs, const HTTPClient& client)
+	const ISteamAPISettings& apiSettings, const std::vector<SteamID>& steamIDs, const HTTPClient& client,
+	HTTPRequestOptions options)
 {
 	if (steamIDs.empty())
 		co_return {};
@@ -217,7 +218,7 @@ mh::task<std::vector<PlayerSummary>> tf2_bot_detector::SteamAPI::GetPlayerSummar
 		GenerateSteamIDsQueryParam(steamIDs, 100));
 
 	auto clientPtr = client.shared_from_this();
-	const std::string data = co_await clientPtr->GetStringAsync(url);
+	const std::string data = co_await clientPtr->GetStringAsync(url, std::move(options));
 
 	nlohmann::json json;
 	try
@@ -263,7 +264,8 @@ void tf2_bot_detector::SteamAPI::from_json(const nlohmann::json& j, PlayerBans&
 }
 
 mh::task<std::vector<PlayerBans>> tf2_bot_detector::SteamAPI::GetPlayerBansAsync(
-	const ISteamAPISettings& apiSettings, const std::vector<SteamID>& steamIDs, const HTTPClient& client)
+	const ISteamAPISettings& apiSettings, const std::vector<SteamID>& steamIDs, const HTTPClient& client,
+	HTTPRequestOptions options)
 {
 	if (steamIDs.empty())
 		co_return std::vector<PlayerBans>();
@@ -275,7 +277,7 @@ mh::task<std::vector<PlayerBans>> tf2_bot_detector::SteamAPI::GetPlayerBansAsync
 	std::string response;
 	try
 	{
-		response = co_await clientPtr->GetStringAsync(url);
+		response = co_await clientPtr->GetStringAsync(url, std::move(options));
 	}
 	catch (const std::exception&)
 	{
@@ -414,7 +416,7 @@ std::error_condition tf2_bot_detector::SteamAPI::make_error_condition(tf2_bot_de
 }
 
 mh::task<std::unordered_set<SteamID>> tf2_bot_detector::SteamAPI::GetFriendList(const ISteamAPISettings& apiSettings,
-	const SteamID& steamID, const HTTPClient& client)
+	const SteamID& steamID, const HTTPClient& client, HTTPRequestOptions options)
 {
 	if (!steamID.IsValid())
 	{
@@ -425,7 +427,7 @@ mh::task<std::unordered_set<SteamID>> tf2_bot_detector::SteamAPI::GetFriendList(
 	auto url = GenerateSteamAPIURL(apiSettings, "/ISteamUser/GetFriendList/v0001", mh::format("?steamid={}", steamID.ID64));
 
 	auto clientPtr = client.shared_from_this();
-	std::string data = co_await clientPtr->GetStringAsync(url);
+	std::string data = co_await clientPtr->GetStringAsync(url, std::move(options));
 
 	const auto json = nlohmann::json::parse(data);
 
@@ -464,7 +466,7 @@ bool SteamAPI::PlayerBans::HasAnyBans() const
 }
 
 mh::task<PlayerInventoryInfo> SteamAPI::GetTF2InventoryInfoAsync(const ISteamAPISettings& apiSettings,
-	const SteamID& steamID, const IHTTPClient& client)
+	const SteamID& steamID, const IHTTPClient& client, HTTPRequestOptions options)
 {
 	if (!steamID.IsValid())
 	{
@@ -479,7 +481,7 @@ mh::task<PlayerInventoryInfo> SteamAPI::GetTF2InventoryInfoAsync(const ISteamAPI
 
 	try
 	{
-		data = co_await clientPtr->GetStringAsync(url);
+		data = co_await clientPtr->GetStringAsync(url, std::move(options));
 	}
 	catch (const http_error& error)
 	{
@@ -2,6 +2,7 @@
 
 #include "Bitmap.h"
 #include "Clock.h"
+#include "HTTPClient.h"
 #include "SteamID.h"
 
 #include <mh/coroutine/task.hpp>
@@ -16,7 +17,6 @@
 
 namespace tf2_bot_detector
 {
-	class IHTTPClient;
 	class ISteamAPISettings;
 
 	enum class PlayerAttribute;
@@ -107,7 +107,7 @@ namespace tf2_bot_detector::SteamAPI
 	void from_json(const nlohmann::json& j, PlayerSummary& d);
 
 	mh::task<std::vector<PlayerSummary>> GetPlayerSummariesAsync(const ISteamAPISettings& apiSettings,
-		const std::vector<SteamID>& steamIDs, const IHTTPClient& client);
+		const std::vector<SteamID>& steamIDs, const IHTTPClient& client, HTTPRequestOptions options = {});
 
 	enum class PlayerEconomyBan
 	{
@@ -132,7 +132,7 @@ namespace tf2_bot_detector::SteamAPI
 	void from_json(const nlohmann::json& j, PlayerBans& d);
 
 	mh::task<std::vector<PlayerBans>> GetPlayerBansAsync(const ISteamAPISettings& apiSettings,
-		const std::vector<SteamID>& steamIDs, const IHTTPClient& client);
+		const std::vector<SteamID>& steamIDs, const IHTTPClient& client, HTTPRequestOptions options = {});
 
 	mh::task<duration_t> GetTF2PlaytimeAsync(const ISteamAPISettings& apiSettings,
 		const SteamID& steamID, const IHTTPClient& client);
@@ -149,14 +149,15 @@ namespace tf2_bot_detector::SteamAPI
 	};
 
 	mh::task<std::unordered_set<SteamID>> GetFriendList(const ISteamAPISettings& apiSettings,
-		const SteamID& steamID, const IHTTPClient& client);
+		const SteamID& steamID, const IHTTPClient& client, HTTPRequestOptions options = {});
 
 	struct PlayerInventoryInfo
 	{
 		uint32_t m_Items = 0;
 		uint32_t m_Slots = 0;
 	};
-	mh::task<PlayerInventoryInfo> GetTF2InventoryInfoAsync(const ISteamAPISettings& apiSettings, const SteamID& steamID, const IHTTPClient& client);
+	mh::task<PlayerInventoryInfo> GetTF2InventoryInfoAsync(const ISteamAPISettings& apiSettings, const SteamID& steamID,
+		const IHTTPClient& client, HTTPRequestOptions options = {});
 
 	std::string GenerateSteamIDsQueryParam(const std::vector<SteamID>& steamIDs, size_t max, MH_SOURCE_LOCATION_AUTO(location));
 }
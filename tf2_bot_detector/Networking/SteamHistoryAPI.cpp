@@ -52,6 +52,23 @@ mh::task<tf2_bot_detector::SteamHistoryAPI::PlayerSourceBansResponse>
 }
 
 
+void tf2_bot_detector::SteamHistoryAPI::to_json(nlohmann::json& j, const BanState& d) {
+	switch (d) {
+	case BanState::Permanent:
+		j = "Permanent";
+		break;
+	case BanState::Current:
+		j = "Temp-Ban";
+		break;
+	case BanState::Unbanned:
+		j = "Unbanned";
+		break;
+	default:
+		j = "Expired";
+		break;
+	}
+}
+
 void tf2_bot_detector::SteamHistoryAPI::from_json(const nlohmann::json& j, BanState& d) {
 	if (j == "Permanent") {
 		d = BanState::Permanent;
@@ -67,6 +84,20 @@ void tf2_bot_detector::SteamHistoryAPI::from_json(const nlohmann::json& j, BanSt
 	}
 }
 
+// The same format from_json reads, so cached bans can be read back with it.
+void tf2_bot_detector::SteamHistoryAPI::to_json(nlohmann::json& j, const PlayerSourceBan& d) {
+	j = {
+		{ "SteamID", d.m_ID },
+		{ "Name", d.m_UserName },
+		{ "CurrentState", d.m_BanState },
+		{ "BanReason", d.m_BanReason },
+		{ "UnbanReason", d.m_UnbanReason },
+		{ "BanTimestamp", std::chrono::duration_cast<std::chrono::seconds>(d.m_BanTimestamp.time_since_epoch()).count() },
+		{ "UnbanTimestamp", std::chrono::duration_cast<std::chrono::seconds>(d.m_UnbanTimestamp.time_since_epoch()).count() },
+		{ "Server", d.m_Server },
+	};
+}
+
 void tf2_bot_detector::SteamHistoryAPI::from_json(const nlohmann::json& j, PlayerSourceBan& d) {
 	d = {};
 
@@ -108,3 +139,16 @@ void tf2_bot_detector::SteamHistoryAPI::from_json(const nlohmann::json& j, Playe
 		d.insert(std::make_pair(SteamID(iter.key()), bans));
 	}
 }
+
+tf2_bot_detector::SteamHistoryAPI::PlayerSourceBanState tf2_bot_detector::SteamHistoryAPI::GetLatestBanPerServer(const PlayerSourceBans& bans) {
+	PlayerSourceBanState banState;
+
+	for (const auto& ban : bans) {
+		// we didn't store this server, or this ban is newer than the one we already stored.
+		if (banState.find(ban.m_Server) == banState.end() || banState.at(ban.m_Server).m_BanTimestamp < ban.m_BanTimestamp) {
+			banState.insert_or_assign(ban.m_Server, ban);
+		}
+	}
+
+	return banState;
+}
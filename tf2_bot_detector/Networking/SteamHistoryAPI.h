@@ -55,10 +55,17 @@ namespace tf2_bot_detector::SteamHistoryAPI
 
 	typedef std::unordered_map<std::string, PlayerSourceBan> PlayerSourceBanState;
 
+	void to_json(nlohmann::json& j, const BanState& d);
 	void from_json(const nlohmann::json& j, BanState& d);
+	void to_json(nlohmann::json& j, const PlayerSourceBan& d);
 	void from_json(const nlohmann::json& j, PlayerSourceBan& d);
 	void from_json(const nlohmann::json& j, PlayerSourceBansResponse& d);
 
+	/// <summary>
+	/// The most recent ban on each server.
+	/// </summary>
+	PlayerSourceBanState GetLatestBanPerServer(const PlayerSourceBans& bans);
+
 	mh::task<PlayerSourceBansResponse> GetPlayerSourceBansAsync(const std::string& apiKey, const std::vector<SteamID>& steamIDs, const HTTPClient& client);
 }
 
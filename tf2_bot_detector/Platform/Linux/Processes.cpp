@@ -22,6 +22,7 @@
 #include <filesystem>
 
 #include <unistd.h>
+#include <sys/resource.h>
 #include <dirent.h>
 #include <signal.h>
 
@@ -101,6 +102,15 @@ size_t tf2_bot_detector::Processes::GetCurrentRAMUsage()
     return 1;
 }
 
+size_t tf2_bot_detector::Processes::GetPeakRAMUsage()
+{
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+
+    return size_t(usage.ru_maxrss) * 1024; // ru_maxrss is in kilobytes
+}
+
 mh::task<std::vector<std::string>> tf2_bot_detector::Processes::GetTF2CommandLineArgsAsync()
 {
     pid_t tf2_pid = 0;
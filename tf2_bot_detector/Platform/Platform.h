@@ -93,6 +93,7 @@ namespace tf2_bot_detector
 			int GetCurrentProcessID();
 
 			size_t GetCurrentRAMUsage();
+			size_t GetPeakRAMUsage();
 		}
 
 		namespace Shell
@@ -344,3 +344,11 @@ size_t tf2_bot_detector::Processes::GetCurrentRAMUsage()
 	mh_ensure(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)));
 	return counters.WorkingSetSize;
 }
+
+size_t tf2_bot_detector::Processes::GetPeakRAMUsage()
+{
+	PROCESS_MEMORY_COUNTERS counters{};
+	counters.cb = sizeof(counters);
+	mh_ensure(GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)));
+	return counters.PeakWorkingSetSize;
+}
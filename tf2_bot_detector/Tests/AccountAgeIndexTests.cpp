@@ -0,0 +1,133 @@
+#include "Util/AccountAgeIndex.h"
+
+#include <catch2/catch.hpp>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+static time_point_t MakeTime(int64_t seconds)
+{
+	return time_point_t(std::chrono::seconds(seconds));
+}
+
+TEST_CASE("tf2bd_account_age_index_estimate", "[AccountAges]")
+{
+	AccountAgeIndex index;
+	REQUIRE(!index.EstimateCreationTime(100));
+
+	index.Insert(1000, MakeTime(10'000));
+	index.Insert(3000, MakeTime(30'000));
+	index.Insert(2000, MakeTime(20'000));
+	REQUIRE(index.size() == 3);
+
+	// Nothing below the first sample to go on
+	REQUIRE(!index.EstimateCreationTime(999));
+
+	// Exact matches
+	REQUIRE(index.EstimateCreationTime(1000) == MakeTime(10'000));
+	REQUIRE(index.EstimateCreationTime(2000) == MakeTime(20'000));
+
+	// Interpolated
+	REQUIRE(index.EstimateCreationTime(1500) == MakeTime(15'000));
+	REQUIRE(index.EstimateCreationTime(2250) == MakeTime(22'500));
+
+	// Newer than the newest sample, so at least as new as it
+	REQUIRE(index.EstimateCreationTime(4'000'000'000) == MakeTime(30'000));
+}
+
+TEST_CASE("tf2bd_account_age_index_estimate_extremes", "[AccountAges]")
+{
+	// The widest possible ranges, in both directions, as an imported file could supply
+	AccountAgeIndex index;
+	index.Insert(0, MakeTime(0));
+	index.Insert(UINT32_MAX, MakeTime(UINT32_MAX));
+	REQUIRE(index.EstimateCreationTime(UINT32_MAX - 1) == MakeTime(UINT32_MAX - 1));
+	REQUIRE(index.EstimateCreationTime(UINT32_MAX / 2) == MakeTime(UINT32_MAX / 2));
+
+	index.Insert(0, MakeTime(UINT32_MAX));
+	index.Insert(UINT32_MAX, MakeTime(0));
+	REQUIRE(index.EstimateCreationTime(1) == MakeTime(UINT32_MAX - 1));
+	REQUIRE(index.EstimateCreationTime(UINT32_MAX - 1) == MakeTime(1));
+}
+
+TEST_CASE("tf2bd_account_age_index_insert", "[AccountAges]")
+{
+	AccountAgeIndex index;
+	index.Insert(2000, MakeTime(20'000));
+	index.Insert(4000, MakeTime(40'000));
+
+	// Replaces a single sample
+	index.Insert(2000, MakeTime(21'000));
+	REQUIRE(index.size() == 2);
+	REQUIRE(index.EstimateCreationTime(2000) == MakeTime(21'000));
+
+	// Bulk inserts come in any order, merge with what is there, and the last one for an account wins
+	index.Insert({
+		AccountAgeIndex::MakeSample(5000, MakeTime(50'000)),
+		AccountAgeIndex::MakeSample(1000, MakeTime(10'000)),
+		AccountAgeIndex::MakeSample(4000, MakeTime(41'000)),
+		AccountAgeIndex::MakeSample(1000, MakeTime(11'000)),
+		AccountAgeIndex::MakeSample(3000, MakeTime(30'000)),
+	});
+
+	const std::vector<AccountAgeIndex::Sample> expected
+	{
+		AccountAgeIndex::MakeSample(1000, MakeTime(11'000)),
+		AccountAgeIndex::MakeSample(2000, MakeTime(21'000)),
+		AccountAgeIndex::MakeSample(3000, MakeTime(30'000)),
+		AccountAgeIndex::MakeSample(4000, MakeTime(41'000)),
+		AccountAgeIndex::MakeSample(5000, MakeTime(50'000)),
+	};
+	REQUIRE(index.GetSamples() == expected);
+}
+
+TEST_CASE("tf2bd_account_age_index_serialize", "[AccountAges]")
+{
+	AccountAgeIndex index;
+	index.Insert({
+		AccountAgeIndex::MakeSample(1, MakeTime(1'060'000'000)),
+		AccountAgeIndex::MakeSample(50'000'000, MakeTime(1'230'000'000)),
+		AccountAgeIndex::MakeSample(50'000'100, MakeTime(1'229'999'000)), // Creation times don't always go up
+		AccountAgeIndex::MakeSample(1'200'000'000, MakeTime(1'600'000'000)),
+		AccountAgeIndex::MakeSample(UINT32_MAX, MakeTime(UINT32_MAX)),
+	});
+
+	const std::string data = AccountAgeIndex::Serialize(index.GetSamples());
+	REQUIRE(AccountAgeIndex::Deserialize(data) == index.GetSamples());
+
+	REQUIRE(AccountAgeIndex::Deserialize(AccountAgeIndex::Serialize({})).empty());
+
+	REQUIRE_THROWS(AccountAgeIndex::Deserialize("not an account ages file"));
+	REQUIRE_THROWS(AccountAgeIndex::Deserialize(std::string_view(data).substr(0, data.size() - 1)));
+
+	// A creation time near the top of the range, then a delta that would overflow int64_t
+	{
+		std::string overflow = AccountAgeIndex::Serialize(std::vector{
+			AccountAgeIndex::Sample{ 1, UINT32_MAX },
+			AccountAgeIndex::Sample{ 2, UINT32_MAX },
+		});
+
+		// Replace the last creation time delta (0, one byte) with the zigzag encoding of INT64_MAX
+		overflow.pop_back();
+		overflow.append("\xFE\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01");
+		REQUIRE_THROWS_AS(AccountAgeIndex::Deserialize(overflow), std::runtime_error);
+	}
+}
+
+TEST_CASE("tf2bd_account_age_index_serialized_size", "[AccountAges]")
+{
+	// Account IDs a few hundred apart, creation times a few seconds apart
+	std::vector<AccountAgeIndex::Sample> samples;
+	uint32_t accountID = 0;
+	uint32_t creationTime = 1'060'000'000;
+	for (uint32_t i = 0; i < 10'000; i++)
+	{
+		accountID += 1 + (i * 37) % 200;
+		creationTime += (i * 13) % 20;
+		samples.push_back(AccountAgeIndex::Sample{ accountID, creationTime - i % 5 });
+	}
+
+	const std::string data = AccountAgeIndex::Serialize(samples);
+	REQUIRE(data.size() < samples.size() * 2.5);
+	REQUIRE(AccountAgeIndex::Deserialize(data) == samples);
+}
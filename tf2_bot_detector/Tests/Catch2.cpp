@@ -70,8 +70,13 @@ namespace Catch
 	}
 }
 
-int tf2_bot_detector::RunTests()
+// Tests run on every startup in debug builds, so benchmarks are tagged "[.][benchmark]" to hide
+// them by default. Run them with --run-tests [benchmark]
+int tf2_bot_detector::RunTests(int argc, const char* const* argv)
 {
 	DebugLog(MH_SOURCE_LOCATION_CURRENT());
+	if (argc > 0)
+		return Catch::Session().run(argc, argv);
+
 	return Catch::Session().run();
 }
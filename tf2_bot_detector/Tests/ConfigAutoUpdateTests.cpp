@@ -0,0 +1,140 @@
+#include "Config/ConfigHelpers.h"
+#include "Networking/HTTPClient.h"
+#include "Networking/HTTPHelpers.h"
+#include "Filesystem.h"
+
+#include <catch2/catch.hpp>
+#include <nlohmann/json.hpp>
+
+#include <vector>
+
+using namespace tf2_bot_detector;
+
+namespace
+{
+	constexpr char UPDATE_URL[] = "https://example.invalid/tf2bd_autoupdate_test.json";
+
+	// Stands in for the update_url server, honoring If-None-Match like a real one would
+	class FakeUpdateServer final : public IHTTPClient
+	{
+	public:
+		std::string GetString(const URL& url) const override { return GetStringAsync(url).get(); }
+		mh::task<std::string> GetStringAsync(URL url, HTTPRequestOptions options = {}) const override
+		{
+			auto response = co_await GetStringIfModifiedAsync(std::move(url), {}, std::move(options));
+			co_return std::move(response.m_Body);
+		}
+
+		mh::task<ConditionalResponse> GetStringIfModifiedAsync(URL url, CacheValidators validators, HTTPRequestOptions options = {}) const override
+		{
+			m_Requests.push_back(validators);
+
+			ConditionalResponse response;
+			if (!validators.m_ETag.empty() && validators.m_ETag == m_ETag)
+			{
+				response.m_NotModified = true;
+				response.m_Validators = std::move(validators);
+			}
+			else
+			{
+				response.m_Body = m_Body;
+				response.m_Validators.m_ETag = m_ETag;
+			}
+
+			co_return std::move(response);
+		}
+
+		RequestCounts GetRequestCounts() const override { return {}; }
+
+		std::string m_Body;
+		std::string m_ETag;
+		mutable std::vector<CacheValidators> m_Requests;
+	};
+
+	class TestConfigFile final : public SharedConfigFileBase
+	{
+	public:
+		void ValidateSchema(const ConfigSchemaInfo& schema) const override
+		{
+			if (schema.m_Type != "playerlist")
+				throw std::runtime_error("Unexpected schema type");
+		}
+
+		void Deserialize(const nlohmann::json& json) override
+		{
+			SharedConfigFileBase::Deserialize(json);
+			json.at("values").get_to(m_Values);
+			m_DeserializeCount++;
+		}
+
+		void Serialize(nlohmann::json& json) const override
+		{
+			SharedConfigFileBase::Serialize(json);
+			json["$schema"] = ConfigSchemaInfo("playerlist", 3);
+			json["values"] = m_Values;
+		}
+
+		std::vector<int> m_Values;
+		int m_DeserializeCount = 0;
+	};
+
+	std::string MakeConfigJSON(const std::vector<int>& values)
+	{
+		return nlohmann::json
+		{
+			{ "$schema", ConfigSchemaInfo("playerlist", 3) },
+			{ "file_info", {
+				{ "authors", { "tf2bd" } },
+				{ "title", "auto-update test" },
+				{ "update_url", UPDATE_URL },
+			} },
+			{ "values", values },
+		}.dump();
+	}
+}
+
+TEST_CASE("tf2bd_config_autoupdate_not_modified", "[Config]")
+{
+	const auto path = IFilesystem::Get().GetTempDir() / "tf2bd_autoupdate_test.json";
+	IFilesystem::Get().WriteFile(path, MakeConfigJSON({ 1 }), PathUsage::WriteLocal);
+
+	auto server = std::make_shared<FakeUpdateServer>();
+	server->m_Body = MakeConfigJSON({ 1, 2, 3 });
+	server->m_ETag = "\"v2\"";
+
+	// First load has nothing to validate against, so it downloads and writes the new version
+	{
+		TestConfigFile file;
+		REQUIRE(!file.LoadFileAsync(path, server).get());
+		REQUIRE(server->m_Requests.size() == 1);
+		REQUIRE(server->m_Requests[0].empty());
+		REQUIRE(file.m_Values == std::vector<int>{ 1, 2, 3 });
+	}
+
+	// Nothing changed on either end: the server says 304, and the file is neither reparsed nor rewritten
+	{
+		const auto lastWriteTime = std::filesystem::last_write_time(path);
+
+		TestConfigFile file;
+		REQUIRE(!file.LoadFileAsync(path, server).get());
+		REQUIRE(server->m_Requests.size() == 2);
+		REQUIRE(server->m_Requests[1].m_ETag == "\"v2\"");
+		REQUIRE(file.m_DeserializeCount == 1);
+		REQUIRE(file.m_Values == std::vector<int>{ 1, 2, 3 });
+		REQUIRE(std::filesystem::last_write_time(path) == lastWriteTime);
+	}
+
+	// Edited locally: the validators no longer apply, so the whole file is downloaded again
+	{
+		IFilesystem::Get().WriteFile(path, MakeConfigJSON({ 4 }), PathUsage::WriteLocal);
+
+		TestConfigFile file;
+		REQUIRE(!file.LoadFileAsync(path, server).get());
+		REQUIRE(server->m_Requests.size() == 3);
+		REQUIRE(server->m_Requests[2].empty());
+		REQUIRE(file.m_Values == std::vector<int>{ 1, 2, 3 });
+	}
+
+	std::filesystem::remove(path);
+	std::filesystem::remove(IFilesystem::Get().GetLocalAppDataDir() / "cache" / "config" / "tf2bd_autoupdate_test.json.update.json");
+}
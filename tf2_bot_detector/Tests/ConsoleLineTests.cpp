@@ -1,5 +1,7 @@
 #include "ConsoleLog/ConsoleLines.h"
+#include "ConsoleLog/NetworkStatus.h"
 #include "SteamID.h"
+#include "Util/RegexCache.h"
 #include "WorldState.h"
 
 #include <catch2/catch.hpp>
@@ -172,3 +174,118 @@ TEST_CASE("tf2bd_cl_status", "[ConsoleLines]")
 		REQUIRE(playerStatus.m_State == test.m_ExpectedState);
 	}
 }
+
+TEST_CASE("tf2bd_cl_dispatch", "[ConsoleLines]")
+{
+	const auto ParseType = [](const std::string_view& text) -> std::optional<ConsoleLineType>
+	{
+		if (auto parsed = IConsoleLine::ParseConsoleLine(text, tfbd_clock_t::now(), s_DummyWorldState))
+			return parsed->GetType();
+
+		return std::nullopt;
+	};
+
+	REQUIRE(ParseType("Client reached server_spawn.") == ConsoleLineType::ClientReachedServerSpawn);
+	REQUIRE(ParseType("Lobby updated") == ConsoleLineType::LobbyChanged);
+	REQUIRE(ParseType("#    348 \"name\" [U:1:1118537734] 00:51  157    0 active") == ConsoleLineType::PlayerStatus);
+	REQUIRE(ParseType("#348 - name") == ConsoleLineType::PlayerStatusShort);
+	REQUIRE(ParseType("  Member[0] [U:1:1118537734]  team = TF_GC_TEAM_DEFENDERS  type = MATCH_PLAYER") == ConsoleLineType::LobbyMember);
+	REQUIRE(ParseType("- Loss:    avg out 0.0, in 0.0") == ConsoleLineType::NetLoss);
+	REQUIRE(ParseType("           per client out 1.5, in 2.5 kB/s") == ConsoleLineType::NetDataPerClient);
+	REQUIRE(ParseType("    53 ms : name") == ConsoleLineType::Ping);
+
+	REQUIRE(!ParseType(""));
+	REQUIRE(!ParseType("   "));
+	REQUIRE(!ParseType("Lobby"));
+	REQUIRE(!ParseType("#"));
+	REQUIRE(!ParseType("Unknown command \"foo\""));
+}
+
+TEST_CASE("tf2bd_cl_fields", "[ConsoleLines]")
+{
+	const auto Parse = [](const std::string_view& text) -> std::shared_ptr<IConsoleLine>
+	{
+		return IConsoleLine::ParseConsoleLine(text, tfbd_clock_t::now(), s_DummyWorldState);
+	};
+
+	{
+		auto line = std::dynamic_pointer_cast<ServerStatusPlayerLine>(
+			Parse("#    348 \"a \"quoted\" name\" [U:1:1118537734] 1:00:51  157    3 spawning 1.2.3.4:27005"));
+		REQUIRE(line);
+		REQUIRE(line->GetPlayerStatus().m_Name == "a \"quoted\" name");
+		REQUIRE(line->GetPlayerStatus().m_Loss == 3);
+		REQUIRE(line->GetPlayerStatus().m_State == PlayerStatusState::Spawning);
+		REQUIRE(line->GetPlayerStatus().m_Address == "1.2.3.4:27005");
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<ServerStatusMapLine>(Parse("map     : cp_at: the map at: -12 x, 0 y, 345 z"));
+		REQUIRE(line);
+		REQUIRE(line->GetMapName() == "cp_at: the map");
+		REQUIRE(line->GetPosition() == std::array<float, 3>{ -12, 0, 345 });
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<ConnectingLine>(Parse("Connecting to matchmaking server 1.2.3.4:27015..."));
+		REQUIRE(line);
+		REQUIRE(line->GetAddress() == "1.2.3.4:27015");
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<SplitPacketLine>(
+			Parse("<-- [cl ] Split packet    2/   3 seq 1234 size  1200 mtu  1260 from 1.2.3.4:27015"));
+		REQUIRE(line);
+		REQUIRE(line->GetSplitPacket().m_Index == 1);
+		REQUIRE(line->GetSplitPacket().m_Count == 3);
+		REQUIRE(line->GetSplitPacket().m_Address == "1.2.3.4:27015");
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<NetStatusConfigLine>(Parse("- Config: Multiplayer, listen, 2 connections"));
+		REQUIRE(line);
+		REQUIRE(line->GetServerMode() == NetStatusConfigLine::ServerMode::Listen);
+		REQUIRE(line->GetConnectionCount() == 2);
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<CvarlistConvarLine>(
+			Parse("sv_gravity                               : 800      : , \"nf\", \"rep\"     : World gravity."));
+		REQUIRE(line);
+		REQUIRE(line->GetConvarName() == "sv_gravity");
+		REQUIRE(line->GetConvarValue() == 800);
+		REQUIRE(line->GetFlagsListString() == ", \"nf\", \"rep\"    "); // Keeps the column padding, like the old regex did
+		REQUIRE(line->GetHelpText() == "World gravity.");
+	}
+
+	{
+		auto line = std::dynamic_pointer_cast<CvarlistConvarLine>(Parse("cl_cmdrate : -1.5 :  : "));
+		REQUIRE(line);
+		REQUIRE(line->GetConvarValue() == -1.5f);
+		REQUIRE(line->GetFlagsListString().empty());
+		REQUIRE(line->GetHelpText().empty());
+	}
+
+	REQUIRE(!Parse("<-- [cl ] Split packet    2/   3 seq 1234 size  1200 mtu  1260 from 1.2.3.4:abc"));
+	REQUIRE(!Parse("edicts  : 100 used of 2048 max and more"));
+}
+
+TEST_CASE("tf2bd_cl_regex_cache", "[ConsoleLines]")
+{
+	const auto Parse = [](const std::string_view& text)
+	{
+		return IConsoleLine::ParseConsoleLine(text, tfbd_clock_t::now(), s_DummyWorldState);
+	};
+
+	REQUIRE(Parse("- latency: 52.1, loss 0.00"));
+	const auto before = RegexCache::Get().GetStats();
+
+	auto line = std::dynamic_pointer_cast<NetChannelLatencyLossLine>(Parse("- latency: 40.5, loss 1.25"));
+	REQUIRE(line);
+	REQUIRE(line->GetLatency() == 40.5f);
+	REQUIRE(line->GetLoss() == 1.25f);
+
+	const auto after = RegexCache::Get().GetStats();
+	REQUIRE(after.m_Misses == before.m_Misses);
+	REQUIRE(after.m_Hits == before.m_Hits + 1);
+	REQUIRE(after.m_PatternCount == before.m_PatternCount);
+}
@@ -0,0 +1,156 @@
+#include "ConsoleLog/ConsoleTimestampScanner.h"
+
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <regex>
+#include <sstream>
+#include <vector>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// The pattern FindConsoleTimestamp replaced in ConsoleLogParser::ParseChunk
+	const std::regex& GetTimestampRegex()
+	{
+		static const std::regex s_TimestampRegex(R"regex(\n(\d\d)\/(\d\d)\/(\d\d\d\d) - (\d\d):(\d\d):(\d\d):[ \n])regex", std::regex::optimize);
+		return s_TimestampRegex;
+	}
+
+	std::vector<size_t> FindAllWithScanner(const std::string_view& text)
+	{
+		std::vector<size_t> retVal;
+		size_t offset = 0;
+		while (auto match = FindConsoleTimestamp(text, offset))
+		{
+			retVal.push_back(match->m_Begin);
+			offset = match->m_End;
+		}
+
+		return retVal;
+	}
+
+	std::vector<size_t> FindAllWithRegex(const std::string_view& text)
+	{
+		std::vector<size_t> retVal;
+		auto begin = text.begin();
+		std::match_results<std::string_view::const_iterator> match;
+		while (std::regex_search(begin, text.end(), match, GetTimestampRegex()))
+		{
+			retVal.push_back(match[0].first - text.begin());
+			begin = match[0].second;
+		}
+
+		return retVal;
+	}
+
+	constexpr std::string_view SAMPLE_LOG =
+		"\n10/17/2026 - 02:42:39: hostname: Valve Matchmaking Server (Virginia iad-1/srcds148 #11)"
+		"\n10/17/2026 - 02:42:39: map     : pl_badwater at: 0 x, 0 y, 0 z"
+		"\n10/17/2026 - 02:42:39: players : 23 humans, 0 bots (24 max)"
+		"\n10/17/2026 - 02:42:39: # userid name                uniqueid            connected ping loss state"
+		"\n10/17/2026 - 02:42:39: #    348 \"Player\" [U:1:1118537734] 00:51  157    0 active"
+		"\n10/17/2026 - 02:42:40: - latency: 52.1, loss 0.00"
+		"\n10/17/2026 - 02:42:40: Player killed Other with scattergun."
+		"\n10/17/2026 - 02:42:41: Some line that wraps"
+		"\nonto a second line without a timestamp 10/17/2026 - 02:42:41:"
+		"\n10/17/2026 - 02:42:41:\n";
+
+	// Set TF2BD_BENCHMARK_CONSOLE_LOG to benchmark against a recorded console.log, otherwise
+	// a representative ~50 MB log is synthesized.
+	const std::string& GetBenchmarkLog()
+	{
+		static const std::string s_Log = []
+		{
+			if (const char* path = std::getenv("TF2BD_BENCHMARK_CONSOLE_LOG"))
+			{
+				std::ifstream file(path, std::ios::binary);
+				std::stringstream ss;
+				ss << file.rdbuf();
+				if (auto str = ss.str(); !str.empty())
+					return str;
+			}
+
+			std::string retVal;
+			retVal.reserve(50 * 1024 * 1024 + SAMPLE_LOG.size());
+			while (retVal.size() < 50 * 1024 * 1024)
+				retVal += SAMPLE_LOG;
+
+			return retVal;
+		}();
+
+		return s_Log;
+	}
+}
+
+TEST_CASE("tf2bd_console_timestamp_scanner", "[ConsoleLog]")
+{
+	const auto match = FindConsoleTimestamp("garbage\n10/17/2026 - 02:42:39: hello"sv);
+	REQUIRE(match);
+	REQUIRE(match->m_Begin == 7);
+	REQUIRE(match->m_End == 31);
+	REQUIRE(match->m_Month == 10);
+	REQUIRE(match->m_Day == 17);
+	REQUIRE(match->m_Year == 2026);
+	REQUIRE(match->m_Hour == 2);
+	REQUIRE(match->m_Minute == 42);
+	REQUIRE(match->m_Second == 39);
+
+	REQUIRE(!FindConsoleTimestamp("10/17/2026 - 02:42:39: no leading newline"sv));
+	REQUIRE(!FindConsoleTimestamp("\n10/17/2026 - 02:42:39:"sv)); // No trailing separator yet
+	REQUIRE(!FindConsoleTimestamp("\n10/17/2026 - 02:4x:39: "sv));
+	REQUIRE(!FindConsoleTimestamp("\n10-17-2026 - 02:42:39: "sv));
+
+	constexpr std::string_view MIXED =
+		"\n\n01/02/2003 - 04:05:06:\n07/08/2009 - 10:11:12: text\n"
+		"\n1/02/2003 - 04:05:06: \n12/31/1999 - 23:59:59: \nend\n12/31/1999 - 23:59";
+	REQUIRE(FindAllWithScanner(MIXED) == FindAllWithRegex(MIXED));
+
+	REQUIRE(FindAllWithScanner(SAMPLE_LOG) == FindAllWithRegex(SAMPLE_LOG));
+}
+
+TEST_CASE("tf2bd_console_timestamp_converter", "[ConsoleLog]")
+{
+	ConsoleTimestampConverter converter;
+
+	ConsoleTimestamp timestamp;
+	timestamp.m_Year = 2026;
+	timestamp.m_Month = 10;
+	timestamp.m_Day = 17;
+	timestamp.m_Hour = 2;
+	timestamp.m_Minute = 42;
+
+	for (int sec : { 0, 39, 59, 12 })
+	{
+		timestamp.m_Second = sec;
+
+		std::tm time{};
+		time.tm_isdst = -1;
+		time.tm_year = timestamp.m_Year - 1900;
+		time.tm_mon = timestamp.m_Month - 1;
+		time.tm_mday = timestamp.m_Day;
+		time.tm_hour = timestamp.m_Hour;
+		time.tm_min = timestamp.m_Minute;
+		time.tm_sec = timestamp.m_Second;
+
+		REQUIRE(converter.ToTimePoint(timestamp) == tfbd_clock_t::from_time_t(std::mktime(&time)));
+	}
+}
+
+TEST_CASE("tf2bd_console_timestamp_benchmark", "[.][benchmark][ConsoleLog]")
+{
+	const std::string_view log = GetBenchmarkLog();
+
+	BENCHMARK("FindConsoleTimestamp")
+	{
+		return FindAllWithScanner(log).size();
+	};
+
+	BENCHMARK("std::regex_search")
+	{
+		return FindAllWithRegex(log).size();
+	};
+}
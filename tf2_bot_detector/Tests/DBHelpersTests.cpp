@@ -0,0 +1,283 @@
+#define DB_HELPERS_OK 1
+#include "DB/DBHelpers.h"
+
+#include <catch2/catch.hpp>
+
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+using namespace tf2_bot_detector;
+using namespace tf2_bot_detector::DB;
+
+namespace
+{
+	enum class TestState
+	{
+		Offline,
+		Online,
+		Away,
+	};
+
+	struct TestRow
+	{
+		uint32_t m_ID = 0;
+		int64_t m_LastUpdateTime = 0;
+		uint32_t m_Count = 0;
+		std::string m_Name;
+		TestState m_State{};
+		bool m_Flag = false;
+		std::optional<int64_t> m_OptionalTime;
+	};
+
+	struct TABLE_TEST final : TableDefinition
+	{
+		TABLE_TEST() : TableDefinition("TABLE_TEST") {}
+
+		const ColumnDefinition COL_ID = Column("ID", ColumnType::Integer, ColumnFlags::PrimaryKeyDefaults);
+		const ColumnDefinition COL_LAST_UPDATE_TIME = Column("LastUpdateTime", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_COUNT = Column("Count", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_NAME = Column("Name", ColumnType::Text, ColumnFlags::NotNull);
+		const ColumnDefinition COL_STATE = Column("State", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_FLAG = Column("Flag", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_OPTIONAL_TIME = Column("OptionalTime", ColumnType::Integer);
+
+	} static const s_TableTest;
+
+	const auto s_TestMapping = RowMapping<TestRow>(s_TableTest)
+		.Column(s_TableTest.COL_ID, &TestRow::m_ID)
+		.Column(s_TableTest.COL_LAST_UPDATE_TIME, &TestRow::m_LastUpdateTime)
+		.Column(s_TableTest.COL_COUNT, &TestRow::m_Count)
+		.Column(s_TableTest.COL_NAME, &TestRow::m_Name)
+		.Column(s_TableTest.COL_STATE, &TestRow::m_State)
+		.Column(s_TableTest.COL_FLAG, &TestRow::m_Flag)
+		.Column(s_TableTest.COL_OPTIONAL_TIME, &TestRow::m_OptionalTime);
+
+	TestRow MakeRow(uint32_t id)
+	{
+		TestRow row;
+		row.m_ID = id;
+		row.m_LastUpdateTime = 1'600'000'000 + id;
+		row.m_Count = id * 3;
+		row.m_Name = "player " + std::to_string(id);
+		row.m_State = TestState(id % 3);
+		row.m_Flag = (id % 2) != 0;
+		if (id % 4)
+			row.m_OptionalTime = 1'200'000'000 + id;
+
+		return row;
+	}
+
+	void RequireEqual(const TestRow& lhs, const TestRow& rhs)
+	{
+		REQUIRE(lhs.m_ID == rhs.m_ID);
+		REQUIRE(lhs.m_LastUpdateTime == rhs.m_LastUpdateTime);
+		REQUIRE(lhs.m_Count == rhs.m_Count);
+		REQUIRE(lhs.m_Name == rhs.m_Name);
+		REQUIRE(lhs.m_State == rhs.m_State);
+		REQUIRE(lhs.m_Flag == rhs.m_Flag);
+		REQUIRE(lhs.m_OptionalTime == rhs.m_OptionalTime);
+	}
+
+	// The way TempDB read rows before RowMapping
+	bool TryGetUncached(SQLite::Database& db, TestRow& row)
+	{
+		auto query = SelectStatementBuilder(s_TableTest.GetTableName())
+			.Where(s_TableTest.COL_ID == row.m_ID)
+			.Run(db);
+
+		if (!query.executeStep())
+			return false;
+
+		row.m_LastUpdateTime = query.getColumn(s_TableTest.COL_LAST_UPDATE_TIME).getInt64();
+		row.m_Count = query.getColumn(s_TableTest.COL_COUNT).getUInt();
+		row.m_Name = query.getColumn(s_TableTest.COL_NAME).getString();
+		row.m_State = TestState(query.getColumn(s_TableTest.COL_STATE).getInt());
+		row.m_Flag = query.getColumn(s_TableTest.COL_FLAG).getInt() != 0;
+
+		if (auto column = query.getColumn(s_TableTest.COL_OPTIONAL_TIME); column.isNull())
+			row.m_OptionalTime.reset();
+		else
+			row.m_OptionalTime = column.getInt64();
+
+		return true;
+	}
+}
+
+TEST_CASE("tf2bd_db_row_mapping", "[DB]")
+{
+	SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+	CreateTable(db, s_TableTest);
+
+	StatementCache statements(db);
+
+	for (uint32_t id = 1; id <= 8; id++)
+		s_TestMapping.Replace(statements, MakeRow(id));
+
+	// Replaces the existing row rather than failing on the primary key
+	TestRow replaced = MakeRow(3);
+	replaced.m_Name = "renamed";
+	replaced.m_OptionalTime.reset();
+	s_TestMapping.Replace(statements, replaced);
+
+	for (uint32_t id = 1; id <= 8; id++)
+	{
+		const TestRow expected = id == 3 ? replaced : MakeRow(id);
+
+		TestRow row;
+		row.m_ID = id;
+		REQUIRE(s_TestMapping.TrySelect(statements, row));
+		RequireEqual(row, expected);
+
+		// Readable the old way too, so nothing about the stored format changed
+		TestRow uncachedRow;
+		uncachedRow.m_ID = id;
+		REQUIRE(TryGetUncached(db, uncachedRow));
+		RequireEqual(uncachedRow, expected);
+	}
+
+	TestRow missing;
+	missing.m_ID = 100;
+	REQUIRE(!s_TestMapping.TrySelect(statements, missing));
+}
+
+TEST_CASE("tf2bd_db_row_mapping_reset", "[DB]")
+{
+	SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+	CreateTable(db, s_TableTest);
+
+	StatementCache statements(db);
+	s_TestMapping.Replace(statements, MakeRow(1));
+
+	const auto throwingMapping = RowMapping<TestRow>(s_TableTest)
+		.Column(s_TableTest.COL_ID, &TestRow::m_ID)
+		.Column(s_TableTest.COL_NAME,
+			[](const TestRow& row) -> const std::string& { return row.m_Name; },
+			[](TestRow& row, const Column2& value) { throw std::runtime_error("bad column"); });
+
+	TestRow row;
+	row.m_ID = 1;
+	REQUIRE_THROWS(throwingMapping.TrySelect(statements, row));
+
+	// A statement left mid-step would keep the table locked
+	REQUIRE_NOTHROW(db.exec("DROP TABLE TABLE_TEST"));
+}
+
+namespace
+{
+	// Shaped like TempDB's LogsTFCacheInfo and AccountInventorySizeInfo, the two lookups the
+	// benchmark compares
+	struct LogsRow
+	{
+		uint32_t m_ID = 0;
+		int64_t m_LastUpdateTime = 0;
+		uint32_t m_LogsCount = 0;
+	};
+
+	struct InventoryRow
+	{
+		uint32_t m_ID = 0;
+		int64_t m_LastUpdateTime = 0;
+		uint32_t m_Items = 0;
+		uint32_t m_Slots = 0;
+	};
+
+	struct TABLE_LOGS final : TableDefinition
+	{
+		TABLE_LOGS() : TableDefinition("TABLE_LOGS") {}
+
+		const ColumnDefinition COL_ID = Column("ID", ColumnType::Integer, ColumnFlags::PrimaryKeyDefaults);
+		const ColumnDefinition COL_LAST_UPDATE_TIME = Column("LastUpdateTime", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_LOG_COUNT = Column("LogCount", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TableLogs;
+
+	struct TABLE_INVENTORY final : TableDefinition
+	{
+		TABLE_INVENTORY() : TableDefinition("TABLE_INVENTORY") {}
+
+		const ColumnDefinition COL_ID = Column("ID", ColumnType::Integer, ColumnFlags::PrimaryKeyDefaults);
+		const ColumnDefinition COL_LAST_UPDATE_TIME = Column("LastUpdateTime", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_ITEM_COUNT = Column("ItemCount", ColumnType::Integer, ColumnFlags::NotNull);
+		const ColumnDefinition COL_SLOT_COUNT = Column("SlotCount", ColumnType::Integer, ColumnFlags::NotNull);
+
+	} static const s_TableInventory;
+
+	const auto s_LogsMapping = RowMapping<LogsRow>(s_TableLogs)
+		.Column(s_TableLogs.COL_ID, &LogsRow::m_ID)
+		.Column(s_TableLogs.COL_LAST_UPDATE_TIME, &LogsRow::m_LastUpdateTime)
+		.Column(s_TableLogs.COL_LOG_COUNT, &LogsRow::m_LogsCount);
+
+	const auto s_InventoryMapping = RowMapping<InventoryRow>(s_TableInventory)
+		.Column(s_TableInventory.COL_ID, &InventoryRow::m_ID)
+		.Column(s_TableInventory.COL_LAST_UPDATE_TIME, &InventoryRow::m_LastUpdateTime)
+		.Column(s_TableInventory.COL_ITEM_COUNT, &InventoryRow::m_Items)
+		.Column(s_TableInventory.COL_SLOT_COUNT, &InventoryRow::m_Slots);
+
+	// The way TempDB::TryGet(LogsTFCacheInfo&) read rows before RowMapping
+	bool TryGetLogsUncached(SQLite::Database& db, LogsRow& row)
+	{
+		auto query = SelectStatementBuilder(s_TableLogs.GetTableName())
+			.Where(s_TableLogs.COL_ID == row.m_ID)
+			.Run(db);
+
+		if (!query.executeStep())
+			return false;
+
+		row.m_LastUpdateTime = query.getColumn(s_TableLogs.COL_LAST_UPDATE_TIME).getInt64();
+		row.m_LogsCount = query.getColumn(s_TableLogs.COL_LOG_COUNT).getUInt();
+		return true;
+	}
+
+	// The way TempDB::Store(AccountInventorySizeInfo&) wrote rows before RowMapping: the query is
+	// generated and compiled every time
+	void StoreInventoryUncached(SQLite::Database& db, const InventoryRow& row)
+	{
+		ReplaceInto(db, s_TableInventory.GetTableName(),
+			{
+				{ s_TableInventory.COL_ID, row.m_ID },
+				{ s_TableInventory.COL_LAST_UPDATE_TIME, row.m_LastUpdateTime },
+				{ s_TableInventory.COL_ITEM_COUNT, row.m_Items },
+				{ s_TableInventory.COL_SLOT_COUNT, row.m_Slots },
+			});
+	}
+}
+
+TEST_CASE("tf2bd_db_row_mapping_benchmark", "[.][benchmark][DB]")
+{
+	SQLite::Database db(":memory:", SQLite::OPEN_READWRITE | SQLite::OPEN_CREATE);
+	CreateTable(db, s_TableLogs);
+	CreateTable(db, s_TableInventory);
+
+	StatementCache statements(db);
+
+	constexpr uint32_t ROW_COUNT = 1000;
+	for (uint32_t id = 1; id <= ROW_COUNT; id++)
+		s_LogsMapping.Replace(statements, LogsRow{ id, 1'600'000'000 + id, id * 3 });
+
+	uint32_t nextID = 0;
+
+	BENCHMARK("TryGet(LogsTFCacheInfo&): SelectStatementBuilder")
+	{
+		LogsRow row;
+		row.m_ID = (nextID++ % ROW_COUNT) + 1;
+		return TryGetLogsUncached(db, row);
+	};
+
+	BENCHMARK("TryGet(LogsTFCacheInfo&): RowMapping")
+	{
+		LogsRow row;
+		row.m_ID = (nextID++ % ROW_COUNT) + 1;
+		return s_LogsMapping.TrySelect(statements, row);
+	};
+
+	BENCHMARK("Store(AccountInventorySizeInfo&): ReplaceInto")
+	{
+		StoreInventoryUncached(db, InventoryRow{ (nextID++ % ROW_COUNT) + 1, 1'600'000'000, 150, 300 });
+	};
+
+	BENCHMARK("Store(AccountInventorySizeInfo&): RowMapping")
+	{
+		s_InventoryMapping.Replace(statements, InventoryRow{ (nextID++ % ROW_COUNT) + 1, 1'600'000'000, 150, 300 });
+	};
+}
@@ -0,0 +1,155 @@
+#include "Networking/HTTPClient.h"
+#include "Networking/HTTPHelpers.h"
+#include "GlobalDispatcher.h"
+
+#include <catch2/catch.hpp>
+#include <mh/text/format.hpp>
+
+#pragma warning(push, 1)
+#include <cpprest/http_listener.h>
+#pragma warning(pop)
+
+#include <atomic>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	// A real server on loopback, so requests go through actual sockets and reuse actual connections
+	class LoopbackServer final
+	{
+	public:
+		LoopbackServer()
+		{
+			// Any port that isn't already taken
+			for (uint16_t port = 27100; !m_Listener; port++)
+			{
+				m_BaseURL = mh::format("http://localhost:{}", port);
+				m_Listener.emplace(utility::conversions::to_string_t(m_BaseURL));
+				m_Listener->support(web::http::methods::GET, [this](const web::http::http_request& request)
+					{
+						m_RequestCount++;
+						request.reply(web::http::status_codes::OK, std::string("tf2bd loopback server"));
+					});
+
+				try
+				{
+					m_Listener->open().wait();
+				}
+				catch (...)
+				{
+					m_Listener.reset();
+					if (port >= 27199)
+						throw;
+				}
+			}
+		}
+		~LoopbackServer()
+		{
+			m_Listener->close().wait();
+		}
+
+		URL GetURL(const std::string_view& path) const { return mh::format("{}{}", m_BaseURL, path); }
+		uint32_t GetRequestCount() const { return m_RequestCount; }
+
+	private:
+		std::string m_BaseURL;
+		std::optional<web::http::experimental::listener::http_listener> m_Listener;
+		std::atomic_uint32_t m_RequestCount = 0;
+	};
+
+	// Rate limited requests wait on the dispatcher, which nothing else is running during the tests
+	std::string WaitForResponse(mh::task<std::string>& request)
+	{
+		while (!request.is_ready())
+			GetDispatcher().run_for(10ms);
+
+		return request.get();
+	}
+
+	void SendConcurrentRequests(const IHTTPClient& client, const URL& url, size_t count)
+	{
+		std::vector<mh::task<IHTTPClient::ConditionalResponse>> requests;
+		requests.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			requests.push_back(client.GetStringIfModifiedAsync(url, {}));
+
+		for (auto& request : requests)
+			request.get();
+	}
+}
+
+TEST_CASE("tf2bd_http_client_coalesced_cancel", "[HTTP]")
+{
+	LoopbackServer server;
+	const auto client = IHTTPClient::Create();
+
+	// Use up the host's burst, so the requests below wait on the rate limit, where cancellation is checked
+	for (int i = 0; i < 2; i++)
+	{
+		auto request = client->GetStringAsync(server.GetURL(mh::format("/tf2bd_coalesced_cancel_burst_{}", i)));
+		WaitForResponse(request);
+	}
+
+	// The first caller gives up, but someone who joined it still wants the response
+	{
+		const URL url = server.GetURL("/tf2bd_coalesced_cancel_joined");
+		bool firstCancelled = false;
+		auto first = client->GetStringAsync(url, { .m_Priority = HTTPRequestPriority::Background, .m_IsCancelled = [&] { return firstCancelled; } });
+		auto joiner = client->GetStringAsync(url, { .m_Priority = HTTPRequestPriority::Interactive, .m_IsCancelled = [] { return false; } });
+		firstCancelled = true;
+
+		REQUIRE(WaitForResponse(joiner) == "tf2bd loopback server");
+		REQUIRE(WaitForResponse(first) == "tf2bd loopback server"); // Still fetched, so no reason to throw it away
+		REQUIRE(server.GetRequestCount() == 3);
+		REQUIRE(client->GetRequestCounts().m_Coalesced == 1);
+	}
+
+	// Once everyone waiting on it has given up, it isn't sent at all
+	{
+		const URL url = server.GetURL("/tf2bd_coalesced_cancel_abandoned");
+		auto first = client->GetStringAsync(url, { .m_IsCancelled = [] { return true; } });
+		auto joiner = client->GetStringAsync(url, { .m_IsCancelled = [] { return true; } });
+
+		REQUIRE_THROWS_AS(WaitForResponse(joiner), std::system_error);
+		REQUIRE_THROWS_AS(WaitForResponse(first), std::system_error);
+		REQUIRE(server.GetRequestCount() == 3);
+	}
+}
+
+TEST_CASE("tf2bd_http_client_benchmark", "[.][benchmark][HTTP]")
+{
+	constexpr size_t REQUEST_COUNT = 200;
+
+	LoopbackServer server;
+	const URL url = server.GetURL("/tf2bd_http_client_benchmark");
+
+	HTTPClientConfig config;
+	config.m_RateLimited = false;
+	const auto client = IHTTPClient::Create(config);
+
+	// No cap, so overlapping requests each open their own connection like they used to
+	HTTPClientConfig uncappedConfig = config;
+	uncappedConfig.m_MaxConnectionsPerHost = REQUEST_COUNT;
+	const auto uncappedClient = IHTTPClient::Create(uncappedConfig);
+
+	BENCHMARK("200 sequential requests")
+	{
+		for (size_t i = 0; i < REQUEST_COUNT; i++)
+			client->GetStringIfModifiedAsync(url, {}).get();
+	};
+
+	BENCHMARK("200 concurrent requests")
+	{
+		SendConcurrentRequests(*client, url, REQUEST_COUNT);
+	};
+
+	BENCHMARK("200 concurrent requests, uncapped connections")
+	{
+		SendConcurrentRequests(*uncappedClient, url, REQUEST_COUNT);
+	};
+}
@@ -0,0 +1,111 @@
+#include "Config/ConfigSnapshot.h"
+#include "Config/PlayerListJSON.h"
+
+#include <catch2/catch.hpp>
+
+using namespace std::string_view_literals;
+using namespace tf2_bot_detector;
+
+namespace
+{
+	PlayerListData MakePlayer(uint64_t id64, const PlayerAttributesList& saved, const PlayerAttributesList& transient = {})
+	{
+		PlayerListData retVal{ SteamID(id64) };
+		retVal.m_SavedAttributes = saved;
+		retVal.m_TransientAttributes = transient;
+		return retVal;
+	}
+}
+
+TEST_CASE("tf2bd_playerlist_index", "[PlayerList]")
+{
+	constexpr uint64_t PLAYER = 76561197960287930;
+	constexpr uint64_t OTHER_PLAYER = 76561197960287931;
+
+	PlayerListIndex index;
+	std::vector<PlayerListIndex::FileID> files;
+	for (int i = 0; i < 6; i++)
+		files.push_back(index.AddFile("file" + std::to_string(i)));
+
+	REQUIRE(index.FindPlayer(SteamID(PLAYER)).empty());
+
+	// Players without attributes are not indexed
+	const auto version = index.GetVersion();
+	index.SetPlayer(files[0], MakePlayer(PLAYER, {}));
+	REQUIRE(index.size() == 0);
+	REQUIRE(index.GetVersion() != version);
+
+	// Marks are kept in file order, both inline and once spilled to the heap
+	for (auto file : { files[4], files[1], files[5], files[0], files[2] })
+		index.SetPlayer(file, MakePlayer(PLAYER, PlayerAttribute::Cheater, PlayerAttribute::Racist));
+
+	index.SetPlayer(files[3], MakePlayer(OTHER_PLAYER, PlayerAttribute::Exploiter));
+	REQUIRE(index.size() == 2);
+
+	auto marks = index.FindPlayer(SteamID(PLAYER));
+	REQUIRE(marks.size() == 5);
+	for (size_t i = 1; i < marks.size(); i++)
+		REQUIRE(marks[i - 1].m_FileID < marks[i].m_FileID);
+
+	REQUIRE(marks[0].GetAttributes(AttributePersistence::Saved) == PlayerAttribute::Cheater);
+	REQUIRE(marks[0].GetAttributes(AttributePersistence::Transient) == PlayerAttribute::Racist);
+	REQUIRE(marks[0].GetAttributes() == (PlayerAttribute::Cheater | PlayerAttribute::Racist));
+
+	// Clearing attributes removes the mark, and the player once no marks are left
+	for (auto file : { files[4], files[0], files[5] })
+		index.SetPlayer(file, MakePlayer(PLAYER, {}));
+
+	marks = index.FindPlayer(SteamID(PLAYER));
+	REQUIRE(marks.size() == 2);
+	REQUIRE(marks[0].m_FileID == files[1]);
+	REQUIRE(marks[1].m_FileID == files[2]);
+
+	index.SetPlayer(files[1], MakePlayer(PLAYER, {}));
+	index.SetPlayer(files[2], MakePlayer(PLAYER, {}));
+	REQUIRE(index.FindPlayer(SteamID(PLAYER)).empty());
+	REQUIRE(index.size() == 1);
+	REQUIRE(index.GetFileName(index.FindPlayer(SteamID(OTHER_PLAYER))[0].m_FileID) == "file3");
+}
+
+TEST_CASE("tf2bd_config_snapshot", "[PlayerList]")
+{
+	ConfigSnapshotKey key;
+	key.m_FileSize = 123456;
+	key.m_LastWriteTime = -42;
+	key.m_ContentHash = ConfigSnapshotKey::HashContents("{}"sv);
+
+	ConfigSnapshotWriter writer;
+	writer.WriteUInt(0);
+	writer.WriteUInt(UINT64_MAX);
+	writer.WriteInt(-1);
+	writer.WriteInt(INT64_MIN);
+	writer.WriteFixed64(76561197960287930);
+	writer.WriteString("proof");
+	writer.WriteString("");
+	writer.WriteString("proof");
+
+	const std::string snapshot = writer.Finish(7, key, R"({"$schema":"x"})"sv);
+
+	ConfigSnapshotReader reader(snapshot);
+	REQUIRE(reader.GetTypeVersion() == 7);
+	REQUIRE(reader.GetKey().m_FileSize == key.m_FileSize);
+	REQUIRE(reader.GetKey().m_LastWriteTime == key.m_LastWriteTime);
+	REQUIRE(reader.GetKey().m_ContentHash == key.m_ContentHash);
+	REQUIRE(reader.GetHeaderJSON() == R"({"$schema":"x"})"sv);
+
+	reader.BeginBody();
+	REQUIRE(reader.ReadUInt() == 0);
+	REQUIRE(reader.ReadUInt() == UINT64_MAX);
+	REQUIRE(reader.ReadInt() == -1);
+	REQUIRE(reader.ReadInt() == INT64_MIN);
+	REQUIRE(reader.ReadFixed64() == 76561197960287930);
+	REQUIRE(reader.ReadString() == "proof"sv);
+	REQUIRE(reader.ReadString() == ""sv);
+	REQUIRE(reader.ReadString() == "proof"sv);
+	REQUIRE(reader.IsEnd());
+	REQUIRE_THROWS(reader.ReadUInt());
+
+	// Anything cut short is rejected rather than read past the end
+	REQUIRE_THROWS(ConfigSnapshotReader(std::string_view(snapshot).substr(0, 20)));
+	REQUIRE_THROWS(ConfigSnapshotReader("TF2BDXXX"sv));
+}
@@ -3,6 +3,7 @@
 
 #include <mh/error/not_implemented_error.hpp>
 #include <mh/text/codecvt.hpp>
+#include <mh/text/format.hpp>
 
 #include <catch2/catch.hpp>
 
@@ -193,3 +194,104 @@ TEST_CASE("Player Rules - chatmsg word", "[PlayerRuleTests]")
 	textMatch.m_Patterns = { "smelly" };
 	REQUIRE(!rule.Match(player, chatMsg));
 }
+
+TEST_CASE("Player Rules - compiled", "[PlayerRuleTests]")
+{
+	MockPlayer player;
+	player.m_Name = "Special Gamer";
+
+	const auto MakeRule = [](TextMatchMode mode, std::vector<std::string> patterns, bool caseSensitive = false)
+	{
+		ModerationRule rule;
+		rule.m_Description = mh::format("{} {}", mh::enum_fmt(mode), patterns.empty() ? "" : patterns.front());
+		auto& textMatch = rule.m_Triggers.m_ChatMsgTextMatch.emplace();
+		textMatch.m_Mode = mode;
+		textMatch.m_Patterns = std::move(patterns);
+		textMatch.m_CaseSensitive = caseSensitive;
+		return rule;
+	};
+
+	std::vector<ModerationRule> rules =
+	{
+		MakeRule(TextMatchMode::Contains, { "ean", "xyz" }),
+		MakeRule(TextMatchMode::Contains, { "MEAN" }, true),
+		MakeRule(TextMatchMode::Contains, { "" }),
+		MakeRule(TextMatchMode::Word, { "stinky", "not a word" }),
+		MakeRule(TextMatchMode::Word, { "You" }, true),
+		MakeRule(TextMatchMode::Regex, { "you.*" }),
+		MakeRule(TextMatchMode::Equal, { "YOU ARE STINKY" }),
+		MakeRule(TextMatchMode::StartsWith, { "mean" }),
+	};
+
+	{
+		auto& usernameRule = rules.emplace_back(MakeRule(TextMatchMode::Contains, { "mean" }));
+		usernameRule.m_Triggers.m_Mode = TriggerMatchMode::MatchAll;
+		usernameRule.m_Triggers.m_UsernameTextMatch.emplace(TextMatch{ TextMatchMode::EndsWith, { "gamer" } });
+	}
+
+	const CompiledModerationRules compiled(rules);
+	REQUIRE(compiled.size() == rules.size());
+
+	for (const std::string_view chatMsg : { "Mean words"sv, "MEAN WORDS"sv, "you are stinky"sv, "you are stinkyy"sv,
+		"YOU ARE STINKY"sv, "You are_stinky"sv, ""sv, "nothing"sv })
+	{
+		const auto matches = compiled.FindMatches(player, chatMsg);
+
+		for (size_t i = 0; i < rules.size(); i++)
+		{
+			const bool expected = rules[i].Match(player, chatMsg);
+			const bool actual = std::any_of(matches.begin(), matches.end(),
+				[&](const CompiledModerationRule* rule) { return rule->GetRule().m_Description == rules[i].m_Description; });
+
+			INFO("Rule: " << rules[i].m_Description << ", message: " << chatMsg);
+			REQUIRE(actual == expected);
+		}
+	}
+}
+
+TEST_CASE("Player Rules - compiled text match", "[PlayerRuleTests]")
+{
+	for (const TextMatchMode mode : { TextMatchMode::Equal, TextMatchMode::Contains, TextMatchMode::StartsWith,
+		TextMatchMode::EndsWith, TextMatchMode::Word })
+	{
+		for (const bool caseSensitive : { false, true })
+		{
+			for (const std::vector<std::string>& patterns : std::initializer_list<std::vector<std::string>>{
+				{ "Special", "gamer" }, { "special gamer", "x" }, { "" }, { "al Ga" }, { "cial", "Special Gamerr" }, {} })
+			{
+				const TextMatch textMatch{ mode, patterns, caseSensitive };
+				const CompiledTextMatch compiled(textMatch);
+
+				for (const std::string_view text : { "Special Gamer"sv, "special gamer"sv, "SpecialGamer"sv, ""sv, "x"sv })
+				{
+					INFO("Mode: " << mh::enum_fmt(mode) << ", case sensitive: " << caseSensitive << ", text: " << text);
+					REQUIRE(compiled.Match(text) == textMatch.Match(text));
+				}
+			}
+		}
+	}
+}
+
+TEST_CASE("Player Rules - text match benchmark", "[.][benchmark][PlayerRuleTests]")
+{
+	TextMatch textMatch{ TextMatchMode::Contains };
+	for (size_t i = 0; i < 10'000; i++)
+		textMatch.m_Patterns.push_back(mh::format("spam pattern {:x}", i * 2654435761u));
+
+	const CompiledTextMatch compiled(textMatch);
+	const std::string chatMsg = "this is a perfectly normal chat message that does not contain any of the patterns, "
+		"just like almost every other message in a real game";
+
+	REQUIRE(!compiled.Match(chatMsg));
+	REQUIRE(compiled.Match(chatMsg + " SPAM PATTERN " + mh::format("{:x}", size_t(9'999) * 2654435761u)));
+
+	BENCHMARK("CompiledTextMatch (10k patterns)")
+	{
+		return compiled.Match(chatMsg);
+	};
+
+	BENCHMARK("TextMatch (10k patterns)")
+	{
+		return textMatch.Match(chatMsg);
+	};
+}
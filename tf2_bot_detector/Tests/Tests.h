@@ -3,6 +3,9 @@
 #ifdef TF2BD_ENABLE_TESTS
 namespace tf2_bot_detector
 {
-	int RunTests();
+	/// <summary>
+	/// Runs the Catch2 tests. Arguments are forwarded to Catch2, argv[0] is ignored.
+	/// </summary>
+	int RunTests(int argc = 0, const char* const* argv = nullptr);
 }
 #endif
@@ -985,7 +985,7 @@ void MainWindow::DrawPlayerTooltipBody(IPlayer& player, TeamShareResult teamShar
 			}
 			else {
 				for (const auto& p : data.m_Proof) {
-					ImGui::TextFmt({ 0, 1, 1, 1 }, "{}", p.get<std::string>().c_str());
+					ImGui::TextFmt({ 0, 1, 1, 1 }, "{}", p);
 				}
 			}
 			ImGui::Unindent(27.0f);
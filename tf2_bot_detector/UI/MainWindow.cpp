@@ -6,6 +6,7 @@
 #include "Platform/Platform.h"
 #include "ImGui_TF2BotDetector.h"
 #include "Actions/ActionGenerators.h"
+#include "Config/AccountAges.h"
 #include "BaseTextures.h"
 #include "Filesystem.h"
 #include "GenericErrors.h"
@@ -15,6 +16,7 @@
 #include "TextureManager.h"
 #include "UpdateManager.h"
 #include "Util/PathUtils.h"
+#include "Util/RegexCache.h"
 #include "Version.h"
 #include "GlobalDispatcher.h"
 #include "Networking/HTTPClient.h"
@@ -462,6 +464,60 @@ catch (...)
 	LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to generate debug_report.zip");
 }
 
+void MainWindow::ExportAccountAges()
+{
+	[](const IAccountAges& accountAges) -> mh::task<>
+	{
+		try
+		{
+			const auto path = IFilesystem::Get().ResolvePath("account_ages.tf2bdages", PathUsage::WriteLocal);
+			co_await accountAges.ExportAsync(path);
+
+			co_await GetDispatcher().co_dispatch();
+			Shell::ExploreToAndSelect(path);
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to export account ages");
+		}
+
+	}(m_Application->GetWorld().GetAccountAges());
+}
+
+void MainWindow::ImportAccountAges()
+{
+	// Imports every export in the folder, so datasets from several machines can go in at once
+	const auto folder = Shell::BrowseForFolderDialog();
+	if (folder.empty())
+		return;
+
+	[](IAccountAges& accountAges, std::filesystem::path folder) -> mh::task<>
+	{
+		try
+		{
+			for (const auto& entry : std::filesystem::directory_iterator(folder))
+			{
+				if (!entry.is_regular_file() || entry.path().extension() != ".tf2bdages")
+					continue;
+
+				try
+				{
+					co_await accountAges.ImportAsync(entry.path());
+				}
+				catch (...)
+				{
+					LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to import account ages from {}", entry.path());
+				}
+			}
+		}
+		catch (...)
+		{
+			LogException(MH_SOURCE_LOCATION_CURRENT(), "Failed to import account ages from {}", folder);
+		}
+
+	}(m_Application->GetWorld().GetAccountAges(), folder);
+}
+
 void MainWindow::OnDrawServerStats()
 {
 	ImGui::PlotLines("Edicts", [&](int idx)
@@ -573,6 +629,12 @@ void MainWindow::OnDraw()
 
 		ImGui::TextFmt("RAM Usage: {:1.1f} MB", Platform::Processes::GetCurrentRAMUsage() / 1024.0f / 1024);
 
+		{
+			const auto regexStats = RegexCache::Get().GetStats();
+			ImGui::TextFmt("Regex Cache: {} patterns | {} hits | {} misses",
+				regexStats.m_PatternCount, regexStats.m_Hits, regexStats.m_Misses);
+		}
+
 		if (auto client = m_Settings.GetHTTPClient())
 		{
 			const IHTTPClient::RequestCounts reqs = client->GetRequestCounts();
@@ -595,6 +657,16 @@ void MainWindow::OnDraw()
 
 			QueuedText(reqs.m_InProgress, "running");
 			QueuedText(reqs.m_Throttled, "throttled");
+
+			ImGui::TextFmt("HTTP Cache: {} hits | {} misses | {} coalesced",
+				reqs.m_CacheHits, reqs.m_CacheMisses, reqs.m_Coalesced);
+
+			for (const auto& host : reqs.m_Hosts)
+			{
+				ImGui::TextFmt(host.m_Queued > 0 ? ImVec4{ 1, 1, 1, 1 } : ImVec4{ 0.5f, 0.5f, 0.5f, 1 },
+					"    {}: {} queued | {}ms avg wait | {}ms interval",
+					host.m_Host, host.m_Queued, host.m_AverageWait.count(), host.m_Interval.count());
+			}
 		}
 		else
 		{
@@ -610,7 +682,8 @@ void MainWindow::OnDraw()
 	{
 		auto& world = m_Application->GetWorld();
 		const auto parsedLineCount = m_Application->m_ParsedLineCount;
-		const auto parseProgress = m_Application->GetMainState()->m_Parser.GetParseProgress();
+		const auto& parser = m_Application->GetMainState()->m_Parser;
+		const auto parseProgress = parser.GetParseProgress();
 
 		if (parseProgress < 0.95f)
 		{
@@ -619,6 +692,8 @@ void MainWindow::OnDraw()
 		}
 
 		ImGui::Value("Parsed line count", parsedLineCount);
+		ImGui::SetHoverTooltip("Console log: {:1.1f} KB/s parsed ({:1.1f} MB/s max throughput)",
+			parser.GetParsedBytesPerSecond() / 1024, parser.GetParseThroughput() / 1024 / 1024);
 
 		ImGui::Text("Connected To:");
 		ImGui::SameLine();
@@ -701,6 +776,13 @@ void MainWindow::OnDrawMenuBar()
 				m_Settings.LoadFile();
 
 			ImGui::Separator();
+
+			if (ImGui::MenuItem("Export Account Ages"))
+				ExportAccountAges();
+			if (ImGui::MenuItem("Import Account Ages..."))
+				ImportAccountAges();
+
+			ImGui::Separator();
 		}
 
 		if (ImGui::MenuItem("Generate Debug Report"))
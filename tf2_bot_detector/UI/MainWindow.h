@@ -85,6 +85,8 @@ namespace tf2_bot_detector
 
 		void PrintDebugInfo();
 		void GenerateDebugReport();
+		void ExportAccountAges();
+		void ImportAccountAges();
 
 		bool IsSleepingEnabled() const;
 
@@ -136,8 +136,8 @@ void PlayerListManagementWindow::DrawFileEntries(const PlayerListJSON::PlayerLis
 			std::string id = "ProofChild_" + steam_id.str();
 
 			if (ImGui::BeginChild(id.c_str(), ImVec2(-FLT_MIN, 0.0f), ImGuiChildFlags_AutoResizeY | ImGuiChildFlags_AutoResizeX)) {
-				for (auto proof : player.m_Proof) {
-					ImGui::Text(proof.get<std::string>().c_str());
+				for (const auto& proof : player.m_Proof) {
+					ImGui::Text(proof.c_str());
 				}
 			}
 			ImGui::EndChild();
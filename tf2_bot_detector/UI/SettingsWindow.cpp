@@ -2,6 +2,7 @@
 #include "MainWindow.h"
 #include "ImGui_TF2BotDetector.h"
 #include "Config/Settings.h"
+#include "DB/TempDB.h"
 #include "SetupFlow/AddonManagerPage.h"
 #include "Util/PathUtils.h"
 #include "Platform/Platform.h"
@@ -312,6 +313,17 @@ void SettingsWindow::OnDrawPerformanceSettings()
 			ImGui::SetHoverTooltip("Slows program refresh rate when not focused to reduce CPU/GPU usage.");
 		}
 
+		// Temp DB size budget
+		{
+			if (ImGui::SliderInt("Cache size limit", &m_Settings.m_TempDBSizeBudgetMB, 16, 1024, "%d MB"))
+			{
+				m_Settings.SaveFile();
+				TF2BDApplication::GetApplication().GetTempDB().SetSizeBudget(m_Settings.GetTempDBSizeBudget());
+			}
+			ImGui::SetHoverTooltip("How much disk space cached player info (Steam profiles, bans, logs.tf, etc) can take up. "
+				"Once it grows past this, the least recently used entries are thrown out.");
+		}
+
 		ImGui::NewLine();
 		ImGui::TreePop();
 	}
@@ -0,0 +1,225 @@
+#include "AccountAgeIndex.h"
+
+#include <mh/text/format.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+using namespace tf2_bot_detector;
+
+auto AccountAgeIndex::MakeSample(uint32_t accountID, time_point_t creationTime) -> Sample
+{
+	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(creationTime.time_since_epoch()).count();
+	assert(seconds >= 0 && seconds <= UINT32_MAX);
+
+	return Sample{ accountID, static_cast<uint32_t>(std::clamp<int64_t>(seconds, 0, UINT32_MAX)) };
+}
+
+void AccountAgeIndex::Insert(uint32_t accountID, time_point_t creationTime)
+{
+	const Sample sample = MakeSample(accountID, creationTime);
+
+	auto it = std::lower_bound(m_Samples.begin(), m_Samples.end(), sample,
+		[](const Sample& lhs, const Sample& rhs) { return lhs.m_AccountID < rhs.m_AccountID; });
+
+	if (it != m_Samples.end() && it->m_AccountID == accountID)
+		*it = sample;
+	else
+		m_Samples.insert(it, sample);
+}
+
+void AccountAgeIndex::Insert(std::vector<Sample> samples)
+{
+	const auto accountIDLess = [](const Sample& lhs, const Sample& rhs) { return lhs.m_AccountID < rhs.m_AccountID; };
+
+	// Sort the new samples, keeping only the last one for each account
+	std::stable_sort(samples.begin(), samples.end(), accountIDLess);
+	{
+		auto out = samples.begin();
+		for (auto it = samples.begin(); it != samples.end(); ++it)
+		{
+			if (out != samples.begin() && std::prev(out)->m_AccountID == it->m_AccountID)
+				*std::prev(out) = *it;
+			else
+				*out++ = *it;
+		}
+
+		samples.erase(out, samples.end());
+	}
+
+	if (m_Samples.empty())
+	{
+		m_Samples = std::move(samples);
+		return;
+	}
+
+	std::vector<Sample> merged;
+	merged.reserve(m_Samples.size() + samples.size());
+
+	auto oldIt = m_Samples.begin();
+	auto newIt = samples.begin();
+	while (oldIt != m_Samples.end() && newIt != samples.end())
+	{
+		if (oldIt->m_AccountID < newIt->m_AccountID)
+		{
+			merged.push_back(*oldIt++);
+		}
+		else
+		{
+			if (oldIt->m_AccountID == newIt->m_AccountID)
+				++oldIt; // Replaced by the new one
+
+			merged.push_back(*newIt++);
+		}
+	}
+
+	merged.insert(merged.end(), oldIt, m_Samples.end());
+	merged.insert(merged.end(), newIt, samples.end());
+	m_Samples = std::move(merged);
+}
+
+std::optional<time_point_t> AccountAgeIndex::EstimateCreationTime(uint32_t accountID) const
+{
+	// First sample at or above the account
+	const auto upper = std::lower_bound(m_Samples.begin(), m_Samples.end(), accountID,
+		[](const Sample& sample, uint32_t id) { return sample.m_AccountID < id; });
+
+	if (upper != m_Samples.end() && upper->m_AccountID == accountID)
+		return upper->GetCreationTime();
+
+	if (upper == m_Samples.begin())
+		return std::nullopt;   // super new, we don't have any data for this
+
+	const auto lower = std::prev(upper);
+	if (upper == m_Samples.end())
+		return lower->GetCreationTime();  // Nothing to interpolate to, pick the lower value
+
+	if (lower->m_CreationTime == upper->m_CreationTime)
+		return lower->GetCreationTime();  // they're the same picture
+
+	// Interpolate the time between the nearest lower and upper account IDs. Creation times don't
+	// always go up, so work with the size of the time difference: a 32-bit time difference times a
+	// 32-bit ID difference only fits in 64 bits unsigned.
+	const uint64_t idOffset = accountID - lower->m_AccountID;
+	const uint64_t idRange = upper->m_AccountID - lower->m_AccountID;
+	const bool timeIncreases = upper->m_CreationTime > lower->m_CreationTime;
+	const uint64_t timeRange = timeIncreases ?
+		upper->m_CreationTime - lower->m_CreationTime : lower->m_CreationTime - upper->m_CreationTime;
+
+	const uint64_t timeOffset = (timeRange * idOffset) / idRange; // idOffset < idRange, so < timeRange
+	const int64_t seconds = timeIncreases ?
+		int64_t(lower->m_CreationTime) + int64_t(timeOffset) : int64_t(lower->m_CreationTime) - int64_t(timeOffset);
+
+	return time_point_t(std::chrono::seconds(seconds));
+}
+
+namespace
+{
+	constexpr std::string_view SERIALIZED_MAGIC = "TF2BDAGE";
+	constexpr uint64_t SERIALIZED_VERSION = 1;
+
+	void WriteVarInt(std::string& out, uint64_t value)
+	{
+		while (value >= 0x80)
+		{
+			out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+			value >>= 7;
+		}
+
+		out.push_back(static_cast<char>(value));
+	}
+
+	uint64_t ReadVarInt(const std::string_view& data, size_t& pos)
+	{
+		uint64_t value = 0;
+		for (unsigned shift = 0; shift < 64; shift += 7)
+		{
+			if (pos >= data.size())
+				throw std::runtime_error("Account ages data is truncated");
+
+			const auto byte = static_cast<uint8_t>(data[pos++]);
+			value |= uint64_t(byte & 0x7F) << shift;
+
+			if (!(byte & 0x80))
+				return value;
+		}
+
+		throw std::runtime_error("Account ages data has a malformed varint");
+	}
+
+	constexpr uint64_t ZigZagEncode(int64_t value)
+	{
+		return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+	}
+
+	constexpr int64_t ZigZagDecode(uint64_t value)
+	{
+		return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+	}
+}
+
+std::string AccountAgeIndex::Serialize(std::span<const Sample> sortedSamples)
+{
+	std::string retVal;
+	retVal.reserve(SERIALIZED_MAGIC.size() + 16 + sortedSamples.size() * 5);
+
+	retVal.append(SERIALIZED_MAGIC);
+	WriteVarInt(retVal, SERIALIZED_VERSION);
+	WriteVarInt(retVal, sortedSamples.size());
+
+	Sample previous{};
+	for (const Sample& sample : sortedSamples)
+	{
+		assert(&sample == sortedSamples.data() || sample.m_AccountID > previous.m_AccountID);
+
+		WriteVarInt(retVal, sample.m_AccountID - previous.m_AccountID);
+		WriteVarInt(retVal, ZigZagEncode(int64_t(sample.m_CreationTime) - int64_t(previous.m_CreationTime)));
+		previous = sample;
+	}
+
+	return retVal;
+}
+
+auto AccountAgeIndex::Deserialize(const std::string_view& data) -> std::vector<Sample>
+{
+	if (!data.starts_with(SERIALIZED_MAGIC))
+		throw std::runtime_error("Not an account ages file");
+
+	size_t pos = SERIALIZED_MAGIC.size();
+	if (const auto version = ReadVarInt(data, pos); version != SERIALIZED_VERSION)
+		throw std::runtime_error(mh::format("Unsupported account ages file version {}", version));
+
+	// Every sample takes at least two bytes, so don't trust a count that can't fit
+	const auto count = ReadVarInt(data, pos);
+	if (count > (data.size() - pos) / 2)
+		throw std::runtime_error("Account ages data is truncated");
+
+	std::vector<Sample> retVal;
+	retVal.reserve(count);
+
+	int64_t accountID = 0;
+	int64_t creationTime = 0;
+	for (uint64_t i = 0; i < count; i++)
+	{
+		const auto idDelta = ReadVarInt(data, pos);
+		if (i > 0 && idDelta == 0)
+			throw std::runtime_error("Account ages data is not sorted");
+
+		accountID += static_cast<int64_t>(std::min<uint64_t>(idDelta, UINT32_MAX + 1ull));
+
+		// Anything bigger can't be a difference between two 32-bit times, and could overflow
+		const int64_t timeDelta = ZigZagDecode(ReadVarInt(data, pos));
+		if (timeDelta > int64_t(UINT32_MAX) || timeDelta < -int64_t(UINT32_MAX))
+			throw std::runtime_error("Account ages data is out of range");
+
+		creationTime += timeDelta;
+
+		if (accountID > UINT32_MAX || creationTime < 0 || creationTime > UINT32_MAX)
+			throw std::runtime_error("Account ages data is out of range");
+
+		retVal.push_back(Sample{ static_cast<uint32_t>(accountID), static_cast<uint32_t>(creationTime) });
+	}
+
+	return retVal;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Clock.h"
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Known account creation times, sorted by account ID. Account IDs are handed out in order,
+	/// so the creation time of an account in between two known ones can be interpolated.
+	/// </summary>
+	class AccountAgeIndex final
+	{
+	public:
+		struct Sample
+		{
+			uint32_t m_AccountID;
+			uint32_t m_CreationTime; // Seconds since the unix epoch
+
+			time_point_t GetCreationTime() const { return time_point_t(std::chrono::seconds(m_CreationTime)); }
+
+			auto operator<=>(const Sample&) const = default;
+		};
+
+		static Sample MakeSample(uint32_t accountID, time_point_t creationTime);
+
+		/// <summary>
+		/// Adds (or replaces) a single sample.
+		/// </summary>
+		void Insert(uint32_t accountID, time_point_t creationTime);
+
+		/// <summary>
+		/// Adds (or replaces) many samples at once, sorting and merging once instead of per sample.
+		/// </summary>
+		void Insert(std::vector<Sample> samples);
+
+		std::optional<time_point_t> EstimateCreationTime(uint32_t accountID) const;
+
+		/// <summary>
+		/// Compact binary form of a set of samples, for sharing them between machines. Samples are
+		/// stored sorted, as varint-encoded deltas from the previous one (zigzag-encoded for the
+		/// creation time, which doesn't always go up). A dense set, with account IDs a few hundred
+		/// apart, takes about 2.4 bytes per sample; a sparse one closer to 6.
+		/// </summary>
+		static std::string Serialize(std::span<const Sample> sortedSamples);
+
+		/// <summary>
+		/// Reads what Serialize() wrote. Throws std::runtime_error if the data is malformed.
+		/// </summary>
+		static std::vector<Sample> Deserialize(const std::string_view& data);
+
+		const std::vector<Sample>& GetSamples() const { return m_Samples; }
+		size_t size() const { return m_Samples.size(); }
+		bool empty() const { return m_Samples.empty(); }
+
+	private:
+		std::vector<Sample> m_Samples;
+	};
+}
@@ -0,0 +1,94 @@
+#include "MultiPatternMatcher.h"
+
+#include <algorithm>
+#include <queue>
+
+using namespace tf2_bot_detector;
+
+auto MultiPatternMatcher::AddPattern(const std::string_view& pattern) -> PatternID
+{
+	const auto id = PatternID(m_PatternLengths.size());
+	m_PatternLengths.push_back(uint32_t(pattern.size()));
+
+	if (pattern.empty())
+		return id;
+
+	uint32_t node = ROOT;
+	for (char c : pattern)
+	{
+		c = FoldCase(c);
+
+		auto& children = m_Nodes[node].m_Children;
+		auto it = std::lower_bound(children.begin(), children.end(), c,
+			[](const std::pair<char, uint32_t>& child, char value) { return child.first < value; });
+
+		if (it != children.end() && it->first == c)
+		{
+			node = it->second;
+		}
+		else
+		{
+			const auto newNode = uint32_t(m_Nodes.size());
+			children.insert(it, { c, newNode });
+			m_Nodes.emplace_back(); // Invalidates children
+			node = newNode;
+		}
+	}
+
+	m_Nodes[node].m_Patterns.push_back(id);
+	return id;
+}
+
+void MultiPatternMatcher::Build()
+{
+	std::fill(std::begin(m_RootTransitions), std::end(m_RootTransitions), ROOT);
+
+	std::queue<uint32_t> queue;
+	for (const auto& [c, child] : m_Nodes[ROOT].m_Children)
+	{
+		m_RootTransitions[uint8_t(c)] = child;
+		m_Nodes[child].m_FailLink = ROOT;
+		m_Nodes[child].m_OutputLink = NONE;
+		queue.push(child);
+	}
+
+	// Breadth first, so every fail link points at a node that has already been finished
+	while (!queue.empty())
+	{
+		const uint32_t node = queue.front();
+		queue.pop();
+
+		for (const auto& [c, child] : m_Nodes[node].m_Children)
+		{
+			const uint32_t fail = Step(m_Nodes[node].m_FailLink, c);
+			m_Nodes[child].m_FailLink = fail;
+			m_Nodes[child].m_OutputLink = m_Nodes[fail].m_Patterns.empty() ? m_Nodes[fail].m_OutputLink : fail;
+			queue.push(child);
+		}
+	}
+}
+
+uint32_t MultiPatternMatcher::FindChild(uint32_t node, char c) const
+{
+	const auto& children = m_Nodes[node].m_Children;
+	auto it = std::lower_bound(children.begin(), children.end(), c,
+		[](const std::pair<char, uint32_t>& child, char value) { return child.first < value; });
+
+	if (it != children.end() && it->first == c)
+		return it->second;
+
+	return NONE;
+}
+
+uint32_t MultiPatternMatcher::Step(uint32_t state, char c) const
+{
+	while (state != ROOT)
+	{
+		if (const auto child = FindChild(state, c); child != NONE)
+			return child;
+
+		state = m_Nodes[state].m_FailLink;
+	}
+
+	return m_RootTransitions[uint8_t(c)];
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Aho-Corasick automaton that finds every occurrence of any number of patterns in a single
+	/// pass over the text. Matching is ASCII case-insensitive; callers that need exact case
+	/// compare the reported range against their pattern themselves.
+	/// </summary>
+	class MultiPatternMatcher final
+	{
+	public:
+		using PatternID = uint32_t;
+
+		static constexpr char FoldCase(char c) { return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c; }
+
+		/// <summary>
+		/// Adds a pattern. Empty patterns are accepted but never reported.
+		/// Invalidates the automaton until Build() is called again.
+		/// </summary>
+		/// <returns>The ID reported for matches of this pattern. IDs are assigned sequentially from 0.</returns>
+		PatternID AddPattern(const std::string_view& pattern);
+
+		/// <summary>
+		/// Computes the failure links. Must be called after adding patterns and before FindAll().
+		/// </summary>
+		void Build();
+
+		size_t GetPatternCount() const { return m_PatternLengths.size(); }
+		bool IsEmpty() const { return m_PatternLengths.empty(); }
+
+		/// <summary>
+		/// Calls func(PatternID, size_t begin, size_t end) for every occurrence of every pattern in the text.
+		/// If func returns bool, returning false stops the search early.
+		/// </summary>
+		template<typename TFunc>
+		void FindAll(const std::string_view& text, TFunc&& func) const
+		{
+			uint32_t state = ROOT;
+			for (size_t i = 0; i < text.size(); i++)
+			{
+				state = Step(state, FoldCase(text[i]));
+
+				for (uint32_t out = m_Nodes[state].m_Patterns.empty() ? m_Nodes[state].m_OutputLink : state;
+					out != NONE; out = m_Nodes[out].m_OutputLink)
+				{
+					for (PatternID id : m_Nodes[out].m_Patterns)
+					{
+						const size_t end = i + 1;
+						if constexpr (std::is_same_v<decltype(func(id, end, end)), bool>)
+						{
+							if (!func(id, end - m_PatternLengths[id], end))
+								return;
+						}
+						else
+						{
+							func(id, end - m_PatternLengths[id], end);
+						}
+					}
+				}
+			}
+		}
+
+	private:
+		static constexpr uint32_t ROOT = 0;
+		static constexpr uint32_t NONE = uint32_t(-1);
+
+		struct Node
+		{
+			std::vector<std::pair<char, uint32_t>> m_Children; // Sorted by char
+			std::vector<PatternID> m_Patterns;                 // Patterns ending exactly here
+			uint32_t m_FailLink = ROOT;
+			uint32_t m_OutputLink = NONE;                      // Nearest node on the fail chain with m_Patterns
+		};
+
+		uint32_t FindChild(uint32_t node, char c) const;
+		uint32_t Step(uint32_t state, char c) const;
+
+		std::vector<Node> m_Nodes{ 1 };
+		std::vector<uint32_t> m_PatternLengths;
+		uint32_t m_RootTransitions[256]{}; // Dense root row, so mismatches fall back in O(1)
+	};
+}
@@ -0,0 +1,35 @@
+#include "RegexCache.h"
+
+using namespace tf2_bot_detector;
+
+RegexCache& RegexCache::Get()
+{
+	static RegexCache s_Instance;
+	return s_Instance;
+}
+
+const std::regex& RegexCache::GetRegex(const std::string_view& pattern)
+{
+	std::lock_guard lock(m_Mutex);
+
+	if (auto found = m_Regexes.find(pattern); found != m_Regexes.end())
+	{
+		m_Hits++;
+		return found->second;
+	}
+
+	m_Misses++;
+	return m_Regexes.emplace(std::string(pattern),
+		std::regex(pattern.data(), pattern.size(), std::regex::optimize)).first->second;
+}
+
+auto RegexCache::GetStats() const -> Stats
+{
+	Stats stats;
+	stats.m_Hits = m_Hits;
+	stats.m_Misses = m_Misses;
+
+	std::lock_guard lock(m_Mutex);
+	stats.m_PatternCount = m_Regexes.size();
+	return stats;
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Process-wide cache of compiled regular expressions, keyed by pattern string. For parsers
+	/// that only know their pattern at runtime, so they can't keep it in a function-local static.
+	/// Compiled regexes are never evicted, and references to them stay valid forever.
+	/// </summary>
+	class RegexCache final
+	{
+	public:
+		static RegexCache& Get();
+
+		/// <summary>
+		/// Returns the compiled (std::regex::optimize) regex for the pattern, compiling it on first use.
+		/// </summary>
+		const std::regex& GetRegex(const std::string_view& pattern);
+
+		struct Stats
+		{
+			uint64_t m_Hits = 0;
+			uint64_t m_Misses = 0;
+			size_t m_PatternCount = 0;
+		};
+		Stats GetStats() const;
+
+	private:
+		RegexCache() = default;
+
+		mutable std::mutex m_Mutex;
+		std::map<std::string, std::regex, std::less<>> m_Regexes;
+
+		std::atomic<uint64_t> m_Hits = 0;
+		std::atomic<uint64_t> m_Misses = 0;
+	};
+}
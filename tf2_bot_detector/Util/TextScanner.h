@@ -0,0 +1,188 @@
+#pragma once
+
+#include <string_view>
+#include <utility>
+
+namespace tf2_bot_detector
+{
+	/// <summary>
+	/// Zero-allocation, left-to-right matcher for the fixed-format lines TF2 prints to the console.
+	/// Used by the console line parsers instead of std::regex.
+	///
+	/// Every Consume* function either advances past what it matched and returns true, or returns
+	/// false without advancing. Captures are views into the scanned text, so they are only valid
+	/// as long as the text is.
+	/// </summary>
+	class TextScanner final
+	{
+	public:
+		constexpr TextScanner(const std::string_view& text) : m_Text(text) {}
+
+		constexpr bool IsEnd() const { return m_Text.empty(); }
+		constexpr std::string_view GetRemaining() const { return m_Text; }
+
+		/// <summary>
+		/// Everything that was consumed between the given (earlier) state of this scanner and now.
+		/// </summary>
+		constexpr std::string_view GetConsumedSince(const TextScanner& earlier) const
+		{
+			return earlier.m_Text.substr(0, earlier.m_Text.size() - m_Text.size());
+		}
+
+		static constexpr bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+		static constexpr bool IsHexDigit(char c) { return IsDigit(c) || (c >= 'a' && c <= 'f'); }
+		static constexpr bool IsWordChar(char c)
+		{
+			return IsDigit(c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+		}
+		static constexpr bool IsWhitespace(char c)
+		{
+			return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f';
+		}
+
+		/// <summary>
+		/// ^\d+$
+		/// </summary>
+		static constexpr bool IsDigits(const std::string_view& str)
+		{
+			TextScanner scanner(str);
+			std::string_view dummy;
+			return scanner.ConsumeDigits(dummy) && scanner.IsEnd();
+		}
+
+		constexpr bool ConsumeLiteral(const std::string_view& literal)
+		{
+			if (!m_Text.starts_with(literal))
+				return false;
+
+			m_Text.remove_prefix(literal.size());
+			return true;
+		}
+
+		/// <summary>
+		/// Consumes the longest run of characters matching the predicate, if it is at least minCount long.
+		/// </summary>
+		template<typename TPred>
+		constexpr bool ConsumeWhile(TPred&& pred, std::string_view& out, size_t minCount = 1)
+		{
+			size_t count = 0;
+			while (count < m_Text.size() && pred(m_Text[count]))
+				count++;
+
+			if (count < minCount)
+				return false;
+
+			out = m_Text.substr(0, count);
+			m_Text.remove_prefix(count);
+			return true;
+		}
+		template<typename TPred>
+		constexpr bool ConsumeWhile(TPred&& pred, size_t minCount = 1)
+		{
+			std::string_view dummy;
+			return ConsumeWhile(std::forward<TPred>(pred), dummy, minCount);
+		}
+
+		constexpr bool ConsumeChars(char c, size_t minCount = 1) { return ConsumeWhile([c](char x) { return x == c; }, minCount); }
+		constexpr bool ConsumeWhitespace(size_t minCount = 1) { return ConsumeWhile(&IsWhitespace, minCount); }                 // \s+
+		constexpr bool ConsumeDigits(std::string_view& out) { return ConsumeWhile(&IsDigit, out); }                             // \d+
+		constexpr bool ConsumeHexDigits(std::string_view& out, size_t minCount = 1) { return ConsumeWhile(&IsHexDigit, out, minCount); } // [0-9a-f]+
+		constexpr bool ConsumeWord(std::string_view& out) { return ConsumeWhile(&IsWordChar, out); }                            // \w+
+
+		/// <summary>
+		/// \d+\.\d+
+		/// </summary>
+		constexpr bool ConsumeDecimal(std::string_view& out)
+		{
+			TextScanner copy = *this;
+			std::string_view dummy;
+			if (!copy.ConsumeDigits(dummy) || !copy.ConsumeLiteral(".") || !copy.ConsumeDigits(dummy))
+				return false;
+
+			out = copy.GetConsumedSince(*this);
+			*this = copy;
+			return true;
+		}
+
+		/// <summary>
+		/// Exactly count characters, whatever they are.
+		/// </summary>
+		constexpr bool ConsumeCount(size_t count, std::string_view& out)
+		{
+			if (m_Text.size() < count)
+				return false;
+
+			out = m_Text.substr(0, count);
+			m_Text.remove_prefix(count);
+			return true;
+		}
+
+		/// <summary>
+		/// (.*?)delimiter -- everything up to the first occurrence of the delimiter. Consumes the delimiter.
+		/// </summary>
+		constexpr bool ConsumeUntil(const std::string_view& delimiter, std::string_view& out)
+		{
+			return ConsumeUntilAt(m_Text.find(delimiter), delimiter, out);
+		}
+
+		/// <summary>
+		/// (.*)delimiter -- everything up to the last occurrence of the delimiter. Consumes the delimiter.
+		/// Equivalent to the greedy regex as long as the rest of the pattern can't match the delimiter.
+		/// </summary>
+		constexpr bool ConsumeUntilLast(const std::string_view& delimiter, std::string_view& out)
+		{
+			return ConsumeUntilAt(m_Text.rfind(delimiter), delimiter, out);
+		}
+
+		/// <summary>
+		/// (.*)suffix$ -- the rest of the text, if it ends with the suffix. Consumes everything.
+		/// </summary>
+		constexpr bool ConsumeUntilSuffix(const std::string_view& suffix, std::string_view& out)
+		{
+			if (!m_Text.ends_with(suffix))
+				return false;
+
+			return ConsumeUntilAt(m_Text.size() - suffix.size(), suffix, out);
+		}
+
+		/// <summary>
+		/// (open.*close) -- greedy, so this ends at the last occurrence of close. Captures the delimiters too.
+		/// </summary>
+		constexpr bool ConsumeEnclosed(char open, char close, std::string_view& out)
+		{
+			if (m_Text.empty() || m_Text.front() != open)
+				return false;
+
+			const auto end = m_Text.rfind(close);
+			if (end == m_Text.npos || end == 0)
+				return false;
+
+			out = m_Text.substr(0, end + 1);
+			m_Text.remove_prefix(end + 1);
+			return true;
+		}
+
+		/// <summary>
+		/// (.*) -- everything that is left.
+		/// </summary>
+		constexpr std::string_view ConsumeRest()
+		{
+			const auto retVal = m_Text;
+			m_Text = {};
+			return retVal;
+		}
+
+	private:
+		constexpr bool ConsumeUntilAt(size_t pos, const std::string_view& delimiter, std::string_view& out)
+		{
+			if (pos == m_Text.npos)
+				return false;
+
+			out = m_Text.substr(0, pos);
+			m_Text.remove_prefix(pos + delimiter.size());
+			return true;
+		}
+
+		std::string_view m_Text;
+	};
+}
@@ -78,10 +78,6 @@ WorldState::~WorldState()
 
 void WorldState::Update()
 {
-	m_PlayerSummaryUpdates.Update();
-	m_PlayerBansUpdates.Update();
-	m_PlayerSourceBansUpdates.Update();
-
 	UpdateFriends();
 }
 
@@ -803,6 +799,22 @@ auto WorldState::GetTeamShareResult(const SteamID& id0, const SteamID& id1) cons
 	return GetTeamShareResult(FindLobbyMemberTeam(id0), FindLobbyMemberTeam(id1));
 }
 
+// Lets the next launch (or lobby) show this without asking the API again
+template<typename TInfo>
+static void StoreInTempDB(TInfo& info)
+{
+	info.m_LastCacheUpdateTime = tfbd_clock_t::now();
+
+	try
+	{
+		TF2BDApplication::GetApplication().GetTempDB().Store(info);
+	}
+	catch (...)
+	{
+		// Already logged, and not worth failing the update over
+	}
+}
+
 template<typename T>
 static std::vector<SteamID> Take100(const T& collection)
 {
@@ -828,8 +840,9 @@ auto WorldState::PlayerSummaryUpdateAction::SendRequest(
 	{
 		for (auto& entry : collection)
 		{
-			if (auto found = state->FindPlayer(entry))
-				static_cast<Player*>(found)->m_PlayerSummary = SteamAPI::ErrorCode::SteamAPIDisabled;
+			// Keep showing anything we had cached
+			if (auto found = static_cast<Player*>(state->FindPlayer(entry)); found && !found->m_PlayerSummary)
+				found->m_PlayerSummary = SteamAPI::ErrorCode::SteamAPIDisabled;
 		}
 		return {};
 	}
@@ -837,7 +850,7 @@ auto WorldState::PlayerSummaryUpdateAction::SendRequest(
 	std::vector<SteamID> steamIDs = Take100(collection);
 
 	return SteamAPI::GetPlayerSummariesAsync(
-		state->GetSettings(), std::move(steamIDs), *client);
+		state->GetSettings(), std::move(steamIDs), *client, { .m_Priority = HTTPRequestPriority::Interactive });
 }
 
 void WorldState::PlayerSummaryUpdateAction::OnDataReady(WorldState*& state,
@@ -851,6 +864,10 @@ void WorldState::PlayerSummaryUpdateAction::OnDataReady(WorldState*& state,
 
 		collection.erase(entry.m_SteamID);
 
+		DB::PlayerSummaryCacheInfo cacheInfo;
+		cacheInfo = entry;
+		StoreInTempDB(cacheInfo);
+
 		if (entry.m_CreationTime.has_value())
 			state->m_AccountAges->OnDataReady(entry.m_SteamID, entry.m_CreationTime.value());
 	}
@@ -867,15 +884,15 @@ auto WorldState::PlayerBansUpdateAction::SendRequest(state_type& state,
 	{
 		for (auto& entry : collection)
 		{
-			if (auto found = state->FindPlayer(entry))
-				static_cast<Player*>(found)->m_PlayerSteamBans = SteamAPI::ErrorCode::SteamAPIDisabled;
+			if (auto found = static_cast<Player*>(state->FindPlayer(entry)); found && !found->m_PlayerSteamBans)
+				found->m_PlayerSteamBans = SteamAPI::ErrorCode::SteamAPIDisabled;
 		}
 		return {};
 	}
 
 	std::vector<SteamID> steamIDs = Take100(collection);
 	return SteamAPI::GetPlayerBansAsync(
-		state->GetSettings(), std::move(steamIDs), *client);
+		state->GetSettings(), std::move(steamIDs), *client, { .m_Priority = HTTPRequestPriority::Interactive });
 }
 
 void WorldState::PlayerBansUpdateAction::OnDataReady(state_type& state,
@@ -886,6 +903,10 @@ void WorldState::PlayerBansUpdateAction::OnDataReady(state_type& state,
 	{
 		state->FindOrCreatePlayer(bans.m_SteamID).m_PlayerSteamBans = bans;
 		collection.erase(bans.m_SteamID);
+
+		DB::PlayerBansCacheInfo cacheInfo;
+		cacheInfo = bans;
+		StoreInTempDB(cacheInfo);
 	}
 }
 
@@ -901,9 +922,9 @@ auto WorldState::PlayerSourceBansUpdateAction::SendRequest(state_type& state,
 		for (auto& entry : collection)
 		{
 			// TODO: make your own custom error... lol.. don't repurpose errors like this...
-			if (auto found = state->FindPlayer(entry)) {
-				static_cast<Player*>(found)->m_PlayerSourceBanState = ErrorCode::InternetConnectivityDisabled;
-				static_cast<Player*>(found)->m_PlayerSourceBans = ErrorCode::InternetConnectivityDisabled;
+			if (auto found = static_cast<Player*>(state->FindPlayer(entry)); found && !found->m_PlayerSourceBanState) {
+				found->m_PlayerSourceBanState = ErrorCode::InternetConnectivityDisabled;
+				found->m_PlayerSourceBans = ErrorCode::InternetConnectivityDisabled;
 			}
 
 		}
@@ -924,31 +945,21 @@ void WorldState::PlayerSourceBansUpdateAction::OnDataReady(state_type& state,
 		auto& player = state->FindOrCreatePlayer(steamID);
 		// SteamHistoryAPI::PlayerSourceBans
 
-		SteamHistoryAPI::PlayerSourceBanState banState;
+		DB::PlayerSourceBansCacheInfo cacheInfo;
+		cacheInfo.m_SteamID = steamID;
 
 		// we have a ban.
 		if (response.find(steamID) != response.end()) {
-			const auto& bans = response.at(steamID);
+			cacheInfo.m_SourceBans = response.at(steamID);
 
-			DebugLog("[SteamHistory] user {} has {} ban records", steamID, bans.size());
-
-			// set our entire history of bans (remove?)
-			player.m_PlayerSourceBans = bans;
+			DebugLog("[SteamHistory] user {} has {} ban records", steamID, cacheInfo.m_SourceBans.size());
+		}
 
-			// set our latest ban state for this user.
-			for (const auto& ban : bans) {
-				// we didn't store this server, or this ban is newer than the one we already stored.
-				if (banState.find(ban.m_Server) == banState.end() || banState.at(ban.m_Server).m_BanTimestamp < ban.m_BanTimestamp) {
-					banState.insert(std::pair(ban.m_Server, ban));
-				}
-			}
+		// set our entire history of bans (remove?), and our latest ban state for this user.
+		player.m_PlayerSourceBans = cacheInfo.m_SourceBans;
+		player.m_PlayerSourceBanState = SteamHistoryAPI::GetLatestBanPerServer(cacheInfo.m_SourceBans);
 
-			player.m_PlayerSourceBanState = banState;
-		}
-		else {
-			player.m_PlayerSourceBanState = banState;
-			player.m_PlayerSourceBans = SteamHistoryAPI::PlayerSourceBans();
-		}
+		StoreInTempDB(cacheInfo);
 	}
 
 	// any other users are either errors (and we should reattempt)
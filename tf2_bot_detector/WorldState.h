@@ -124,6 +124,7 @@ namespace tf2_bot_detector
 		virtual const std::string& GetMapName() const = 0;
 
 		virtual const IAccountAges& GetAccountAges() const = 0;
+		IAccountAges& GetAccountAges() { return const_cast<IAccountAges&>(std::as_const(*this).GetAccountAges()); }
 	};
 
 	inline mh::generator<IPlayer&> IWorldState::GetLobbyMembers()